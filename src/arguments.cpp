@@ -19,6 +19,7 @@
 
 #include <arguments.h>
 #include <marshal.h>
+#include <string_pool.h>
 
 // the argument list is documented if one of its arguments is documented
 bool ArgumentList::hasDocumentation() const
@@ -33,6 +34,26 @@ bool ArgumentList::hasDocumentation() const
    return false;
 }
 
+bool ArgumentList::sameShape(const ArgumentList &other, bool checkCV) const
+{
+   if (count() != other.count()) {
+      return false;
+   }
+
+   if (checkCV && (constSpecifier != other.constSpecifier || volatileSpecifier != other.volatileSpecifier)) {
+      return false;
+   }
+
+   return refSpecifier == other.refSpecifier;
+}
+
+void ArgumentList::clearCanonicalTypes()
+{
+   for (auto &item : *this) {
+      item.canType = QString();
+   }
+}
+
 ArgumentList ArgumentList::unmarshal(StorageIntf *s)
 {
    uint i;
@@ -48,24 +69,26 @@ ArgumentList ArgumentList::unmarshal(StorageIntf *s)
    for (i = 0; i < count; i++) {
       Argument a;
 
-      a.attrib  = unmarshalQString(s);
-      a.type    = unmarshalQString(s);
+      a.attrib  = StringPool::intern(unmarshalQString(s));
+      a.type    = StringPool::intern(unmarshalQString(s));
       a.canType = unmarshalQString(s);
-      a.name    = unmarshalQString(s);
-      a.array   = unmarshalQString(s);
+      a.name    = StringPool::intern(unmarshalQString(s));
+      a.array   = StringPool::intern(unmarshalQString(s));
       a.defval  = unmarshalQString(s);
       a.docs    = unmarshalQString(s);
       a.typeConstraint = unmarshalQString(s);
 
-      result.append(a);
+      result.append(std::move(a));
    }
 
-   result.constSpecifier     = unmarshalBool(s);
-   result.volatileSpecifier  = unmarshalBool(s);
-   result.pureSpecifier      = unmarshalBool(s);
+   uint flags                = unmarshalFlags(s);
+   result.constSpecifier     = flags & (1 << 0);
+   result.volatileSpecifier  = flags & (1 << 1);
+   result.pureSpecifier      = flags & (1 << 2);
+   result.isDeleted          = flags & (1 << 3);
+
    result.refSpecifier       = static_cast<RefType>(unmarshalInt(s));
    result.trailingReturnType = unmarshalQString(s);
-   result.isDeleted          = unmarshalBool(s);
 
    return result;
 }
@@ -85,11 +108,8 @@ void ArgumentList::marshal(StorageIntf *s, const ArgumentList &argList)
       marshalQString(s, item.typeConstraint);
    }
 
-   marshalBool(s,    argList.constSpecifier);
-   marshalBool(s,    argList.volatileSpecifier);
-   marshalBool(s,    argList.pureSpecifier);
+   marshalFlags(s,   { argList.constSpecifier, argList.volatileSpecifier, argList.pureSpecifier, argList.isDeleted });
    marshalInt(s,     argList.refSpecifier);
    marshalQString(s, argList.trailingReturnType);
-   marshalBool(s,    argList.isDeleted);
 }
 
@@ -21,6 +21,8 @@
 #include <QString>
 #include <QVector>
 
+#include <utility>
+
 #include <types.h>
 
 class StorageIntf;
@@ -29,18 +31,21 @@ class StorageIntf;
 struct Argument {
    Argument() {}
 
-   // copy constructor
-   Argument(const Argument &a) {
-      attrib  = a.attrib;
-      type    = a.type;
-      name    = a.name;
-      defval  = a.defval;
-      docs    = a.docs;
-      array   = a.array;
-      typeConstraint = a.typeConstraint;
-   }
+   // the cached canonical type is not copied, it depends on the scope the argument was resolved in
 
-   // Assignment operator
+   // copy constructor
+   Argument(const Argument &a)
+      : attrib(a.attrib), type(a.type), name(a.name), array(a.array), defval(a.defval),
+        docs(a.docs), typeConstraint(a.typeConstraint)
+   {}
+
+   // move constructor
+   Argument(Argument &&a)
+      : attrib(std::move(a.attrib)), type(std::move(a.type)), name(std::move(a.name)), array(std::move(a.array)),
+        defval(std::move(a.defval)), docs(std::move(a.docs)), typeConstraint(std::move(a.typeConstraint))
+   {}
+
+   // copy assignment
    Argument &operator=(const Argument &a) {
       if (this != &a) {
          attrib = a.attrib;
@@ -54,6 +59,20 @@ struct Argument {
       return *this;
    }
 
+   // move assignment
+   Argument &operator=(Argument &&a) {
+      if (this != &a) {
+         attrib = std::move(a.attrib);
+         type   = std::move(a.type);
+         name   = std::move(a.name);
+         defval = std::move(a.defval);
+         docs   = std::move(a.docs);
+         array  = std::move(a.array);
+         typeConstraint = std::move(a.typeConstraint);
+      }
+      return *this;
+   }
+
    // return true if this argument is documentation and the argument has a  non empty name 
    bool hasDocumentation() const {
       return ! name.isEmpty() && ! docs.isEmpty();
@@ -83,12 +102,15 @@ class ArgumentList : public QVector<Argument>
    {
    }
 
-   /*! Destroys the argument list */
-   ~ArgumentList() {}
-
    /*! Does any argument of this list have documentation? */
    bool hasDocumentation() const;
 
+   /*! Do both lists have the same number of arguments and qualifiers? Otherwise they never match. */
+   bool sameShape(const ArgumentList &other, bool checkCV) const;
+
+   /*! Clears the canonical types cached in the arguments, these depend on the scope they were resolved for */
+   void clearCanonicalTypes();
+
    /*! Does the member modify the state of the class? default: false. */
    bool constSpecifier;
 
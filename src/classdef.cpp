@@ -33,6 +33,7 @@
 #include <language.h>
 #include <layout.h>
 #include <message.h>
+#include <string_pool.h>
 #include <util.h>
 
 ClassDef::ClassDef(const QString &defFileName, int defLine, int defColumn, const QString &x_name, CompoundType ct,
@@ -594,12 +595,12 @@ void ClassDef::setIncludeFile(QSharedPointer<FileDef> fd, const QString &include
    if ((! includeName.isEmpty() && m_incInfo.includeName.isEmpty()) || (fd != nullptr && m_incInfo.fileDef == nullptr) ) {
 
       m_incInfo.fileDef     = fd;
-      m_incInfo.includeName = includeName;
+      m_incInfo.includeName = StringPool::intern(includeName);
       m_incInfo.local       = local;
    }
 
    if (force && ! includeName.isEmpty()) {
-      m_incInfo.includeName = includeName;
+      m_incInfo.includeName = StringPool::intern(includeName);
       m_incInfo.local       = local;
    }
 }
@@ -141,6 +141,7 @@ void Config::load_Defaults()
 
    m_cfgInt.insert("tab-size",                   struc_CfgInt    { 4,              DEFAULT } );
    m_cfgInt.insert("lookup-cache-size",          struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgInt.insert("entry-cache-size",           struc_CfgInt    { 256,            DEFAULT } );
 
    // tab 2 - build confg
    m_cfgBool.insert("extract-all",               struc_CfgBool   { false,          DEFAULT } );
@@ -236,6 +237,8 @@ void Config::load_Defaults()
 
    m_cfgString.insert("input-encoding",          struc_CfgString { "UTF-8",         DEFAULT } );
    m_cfgBool.insert("input-recursive",           struc_CfgBool   { false,           DEFAULT } );
+   m_cfgInt.insert("parse-num-threads",          struc_CfgInt    { 1,               DEFAULT } );
+   m_cfgBool.insert("parse-cache",               struc_CfgBool   { false,           DEFAULT } );
 
    m_cfgList.insert("exclude-files",             struc_CfgList   { QStringList(),   DEFAULT } );
    m_cfgBool.insert("exclude-symlinks",          struc_CfgBool   { false,           DEFAULT } );
@@ -287,6 +290,8 @@ void Config::load_Defaults()
 
    m_cfgBool.insert("clang-parsing",             struc_CfgBool   { false,          DEFAULT } );
    m_cfgList.insert("clang-flags",               struc_CfgList   { QStringList(),  DEFAULT } );
+   m_cfgString.insert("clang-pch-header",        struc_CfgString { QString(),      DEFAULT } );
+   m_cfgString.insert("clang-compilation-path",  struc_CfgString { QString(),      DEFAULT } );
 
    // tab 2 - preprocessor
    m_cfgBool.insert("enable-preprocessing",      struc_CfgBool   { true,           DEFAULT } );
@@ -24,4 +24,6 @@
 
 extern void parseFuncDecl(const QString &decl, bool objC, QString &clName, QString &type,
                   QString &name, QString &args, QString &funcTempList, QString &exceptions);
+
+extern void addFuncDeclStatistics();
 #endif
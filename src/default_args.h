@@ -27,4 +27,6 @@ ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList
 
 ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList &argList, QString &extraTypeChars);
 
+void addArgumentListStatistics();
+
 #endif
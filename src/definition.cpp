@@ -34,6 +34,7 @@
 #include <marshal.h>
 #include <outputlist.h>
 #include <parse_base.h>
+#include <string_pool.h>
 #include <util.h>
 
 #define START_MARKER 0x4445465B    // DEF[
@@ -99,7 +100,7 @@ Definition_Private::~Definition_Private()
 
 void Definition_Private::init(const QString &df, const QString &n)
 {
-   defFileName = df;
+   defFileName = StringPool::intern(df);
    int lastDot = defFileName.lastIndexOf('.');
 
    if (lastDot != -1) {
@@ -109,7 +110,7 @@ void Definition_Private::init(const QString &df, const QString &n)
    QString name = n;
 
    if (name != "<globalScope>") {
-      localName = stripScope(n);
+      localName = StringPool::intern(stripScope(n));
 
    } else {
       localName = n;
@@ -198,7 +199,7 @@ void Definition::addToMap(const QString &name)
 
    if (! phrase.isEmpty()) {
       // must use a raw pointer since this method is called from a constructor
-      Doxy_Globals::glossary().insertMulti(phrase, this);
+      Doxy_Globals::glossary().insert(phrase, this);
       this->setPhraseName(phrase);
    }
 }
@@ -206,7 +207,7 @@ void Definition::addToMap(const QString &name)
 Definition::Definition(const QString &df, int dl, int dc, const QString &name, const QString &briefDoc,
                   const QString &fullDoc, bool isPhrase)
 {
-   m_name      = name;
+   m_name      = StringPool::intern(name);
    m_defLine   = dl;
    m_defColumn = dc;
 
@@ -277,18 +278,7 @@ Definition::~Definition()
    }
 
    if (! Doxy_Globals::programExit)  {
-      auto iter = Doxy_Globals::glossary().find(m_phraseName);
-
-      while (iter != Doxy_Globals::glossary().end() && iter.key() == m_phraseName)  {
-
-         if (iter.value() == this) {
-            iter = Doxy_Globals::glossary().erase(iter);
-
-         }  else {
-            ++iter;
-
-         }
-      }
+      Doxy_Globals::glossary().remove(m_phraseName, this);
    }
 }
 
@@ -298,7 +288,7 @@ void Definition::setName(const QString &name)
       return;
    }
 
-   m_name = name;
+   m_name = StringPool::intern(name);
 }
 
 void Definition::setId(const QString &id)
@@ -1247,7 +1237,8 @@ QString Definition::qualifiedName() const
       m_private->qualifiedName = m_private->localName;
 
    } else {
-      m_private->qualifiedName = m_private->outerScope->qualifiedName() + getLanguageSpecificSeparator(getLanguage()) + m_private->localName;
+      m_private->qualifiedName = StringPool::intern(m_private->outerScope->qualifiedName() +
+                  getLanguageSpecificSeparator(getLanguage()) + m_private->localName);
    }
 
    return m_private->qualifiedName;
@@ -1267,6 +1258,8 @@ void Definition::setOuterScope(QSharedPointer<Definition> d)
    if (! found) {
       m_private->qualifiedName.resize(0); // flush cached scope name
       m_private->outerScope = d;
+
+      accessIndexScopeMoved(this);
    }
 
    m_private->hidden = m_private->hidden || d->isHidden();
@@ -1814,7 +1807,7 @@ void Definition::setArtificial(bool b)
 
 void Definition::setLocalName(const QString &name)
 {
-   m_private->localName = name;
+   m_private->localName = StringPool::intern(name);
 }
 
 void Definition::setLanguage(SrcLangExt lang)
@@ -1824,7 +1817,7 @@ void Definition::setLanguage(SrcLangExt lang)
 
 void Definition::setPhraseName(const QString &phrase)
 {
-   m_phraseName = phrase;
+   m_phraseName = StringPool::intern(phrase);
 }
 
 bool Definition::hasBriefDescription() const
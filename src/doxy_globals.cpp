@@ -82,7 +82,7 @@ QHash<QString, QSharedPointer<Definition>>   Doxy_Globals::clangUsrMap;
 QHash<long, QSharedPointer<MemberGroupInfo>> Doxy_Globals::memGrpInfoDict;    // dictionary of the member groups heading
 
 StringMap<QSharedPointer<DirRelation>>       Doxy_Globals::dirRelations;
-QCache<QString, LookupInfo>                  Doxy_Globals::lookupCache;
+LookupCache                                  Doxy_Globals::lookupCache;
 
 QString Doxy_Globals::htmlFileExtension;
 QString Doxy_Globals::latexStyleExtension = ".sty";
@@ -108,6 +108,8 @@ int Doxy_Globals::documentedSrcFiles;
 int Doxy_Globals::documentedPages;
 int Doxy_Globals::indexedPages;
 int Doxy_Globals::subpageNestingLevel;
+int Doxy_Globals::parseSideEffects = 0;
+int Doxy_Globals::anonNSCount      = 0;
 
 QDateTime Doxy_Globals::dateTime;
 
@@ -120,8 +122,8 @@ QSet<QString>             Doxy_Globals::g_pathsVisited;
 
 QMap<QString, QString>    Doxy_Globals::g_moduleHint;               // experimental
 
-QMultiHash<QString, Definition *>  &Doxy_Globals::glossary()
+SymbolTable &Doxy_Globals::glossary()
 {
-   static QMultiHash<QString, Definition *> data;
+   static SymbolTable data;
    return data;
 }
@@ -19,9 +19,7 @@
 #define DOXY_GLOBALS_H
 
 #include <QByteArray>
-#include <QCache>
 #include <QHash>
-#include <QMultiHash>
 #include <QList>
 #include <QString>
 #include <QSharedPointer>
@@ -35,6 +33,7 @@
 #include <filestorage.h>
 #include <formula.h>
 #include <groupdef.h>
+#include <lookup_cache.h>
 #include <membergroup.h>
 #include <membername.h>
 #include <message.h>
@@ -44,20 +43,7 @@
 #include <reflist.h>
 #include <searchindex.h>
 #include <stringmap.h>
-
-struct LookupInfo {
-   LookupInfo() {}
-
-   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
-      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
-   {}
-
-   QSharedPointer<ClassDef>  classDef;
-   QSharedPointer<MemberDef> typeDef;
-
-   QString templSpec;
-   QString resolvedType;
-};
+#include <symbol_table.h>
 
 class StringDict : public QHash<QString, QString>
 {
@@ -88,6 +74,11 @@ class Statistics
       statList.last().elapsed = ((double)time.elapsed()) / 1000.00;
    }
 
+   void addCounter(const QString &name, long value) {
+      CounterData entry(name, value);
+      counterList.append(std::move(entry));
+   }
+
    void print() {
       msg("\n");
       msg("----------------------\n");
@@ -95,9 +86,25 @@ class Statistics
       for (const auto &item : statList) {
          msg("%.3f seconds %s", item.elapsed, csPrintable(item.name));
       }
+
+      if (! counterList.isEmpty()) {
+         msg("\n");
+
+         for (const auto &item : counterList) {
+            msg("%10ld %s\n", item.value, csPrintable(item.name));
+         }
+      }
    }
 
  private:
+   struct CounterData {
+      CounterData(const QString &n, long v) : name(n), value(v)
+      {}
+
+      QString name;
+      long value;
+   };
+
    struct StatData {
       StatData(const QString &n) : name(n), elapsed(0)
       {}
@@ -107,6 +114,7 @@ class Statistics
    };
 
    QList<StatData> statList;
+   QList<CounterData> counterList;
    QTime time;
 };
 
@@ -184,7 +192,7 @@ class Doxy_Globals
       static QHash<long, QSharedPointer<MemberGroupInfo>> memGrpInfoDict;
 
       static StringMap<QSharedPointer<DirRelation>>       dirRelations;
-      static QCache<QString, LookupInfo>                  lookupCache;
+      static LookupCache                                  lookupCache;
 
       static QString htmlFileExtension;
       static QString latexStyleExtension;
@@ -211,6 +219,12 @@ class Doxy_Globals
       static int indexedPages;
       static int subpageNestingLevel;
 
+      // incremented by the parsers when an input file changes global state
+      static int parseSideEffects;
+
+      // incremented for every file parsed by the C-style scanner, names anonymous namespaces
+      static int anonNSCount;
+
       static QDateTime dateTime;
 
       static QHash<QString, QSharedPointer<EntryNav>>   g_classEntries;
@@ -222,7 +236,7 @@ class Doxy_Globals
       static QHash<QString, FileDef>   g_usingDeclarations;
 
       // must use a raw pointer since this method is called from a constructor
-      static QMultiHash<QString, Definition *> &glossary();
+      static SymbolTable &glossary();
 };
 
 #endif
\ No newline at end of file
@@ -22,6 +22,9 @@
 #include <sys/stat.h>
 #include <set>
 
+#include <QThread>
+#include <QVector>
+
 #include <arguments.h>
 #include <cite.h>
 #include <cmdmapper.h>
@@ -40,6 +43,7 @@
 #include <doxy_globals.h>
 #include <eclipsehelp.h>
 #include <entry.h>
+#include <entry_pass.h>
 #include <filestorage.h>
 #include <formula.h>
 #include <ftvhelp.h>
@@ -57,6 +61,7 @@
 #include <objcache.h>
 #include <outputlist.h>
 #include <parse_base.h>
+#include <parse_cache.h>
 #include <parse_clang.h>
 #include <parse_cstyle.h>
 #include <parse_file.h>
@@ -71,6 +76,7 @@
 #include <qhp.h>
 #include <rtfgen.h>
 #include <store.h>
+#include <string_pool.h>
 #include <tagreader.h>
 #include <util.h>
 #include <xmlgen.h>
@@ -439,7 +445,7 @@ void processFiles()
    }
 
    uint lookupSize = (65536 << cacheSize);
-   Doxy_Globals::lookupCache.setMaxCost(lookupSize);
+   Doxy_Globals::lookupCache.setMaxSize(lookupSize);
 
 #ifdef HAS_SIGNALS
    signal(SIGINT, stopDoxyPress);
@@ -600,13 +606,18 @@ void processFiles()
       addSTLClasses(rootNav);
    }
 
+   ParseCache::instance()->initialize(outputDirectory);
+
    msg("\n**  ");
    Doxy_Globals::infoLog_Stat.begin("Parsing\n");
    parseFiles(root, rootNav);
+   ParseCache::instance()->printStatistics();
 
    Doxy_Globals::fileStorage.close();
    Doxy_Globals::infoLog_Stat.end();
 
+   preAddStatistics();
+
    // done with input scanning, free up the buffers used by lex (can be around 4MB)
    preFreeScanner();
    cstyleFreeParser();
@@ -617,6 +628,9 @@ void processFiles()
       stopDoxyPress();
    }
 
+   // the tree is complete, passes which only handle a few sections visit the matching nodes
+   EntrySectionIndex sectionIndex(rootNav);
+
    // gather information
    Doxy_Globals::infoLog_Stat.begin("Building group list\n");
    buildGroupList(rootNav);
@@ -625,7 +639,13 @@ void processFiles()
 
    Doxy_Globals::infoLog_Stat.begin("Building directory list\n");
    buildDirectories();
-   findDirDocumentation(rootNav);
+
+   {
+      EntryPassList passList;
+      passList.addPass({Entry::DIRDOC_SEC}, findDirDocumentation);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
+
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Building namespace list\n");
@@ -660,12 +680,20 @@ void processFiles()
    // calling buildClassList may result in cached relations which become invalid
    // after resolveClassNestingRelations(), that is why we clear the cache here
    Doxy_Globals::lookupCache.clear();
+   clearCanonicalTypeCache();
+   clearLookupNameCache();
 
    // we do not need the list of using declaration anymore
    Doxy_Globals::g_usingDeclarations.clear();
 
    Doxy_Globals::infoLog_Stat.begin("Building example list\n");
-   buildExampleList(rootNav);
+
+   {
+      EntryPassList passList;
+      passList.addPass({Entry::EXAMPLE_SEC}, buildExampleList);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
+
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Searching for enumerations\n");
@@ -688,6 +716,9 @@ void processFiles()
 
    Doxy_Globals::infoLog_Stat.begin("Searching for included using directives\n");
    findIncludedUsingDirectives();
+
+   // all using relations are known, accessibility of symbols can be looked up from now on
+   enableAccessIndex();
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Searching for documented variables\n");
@@ -708,7 +739,13 @@ void processFiles()
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Searching for documented defines\n");
-   findDefineDocumentation(rootNav);
+
+   {
+      EntryPassList passList;
+      passList.addPass({Entry::DEFINEDOC_SEC, Entry::DEFINE_SEC}, findDefineDocumentation);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
+
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Computing class inheritance relations\n");
@@ -760,17 +797,33 @@ void processFiles()
    resolveHiddenNamespace();
    Doxy_Globals::infoLog_Stat.end();
 
-   Doxy_Globals::infoLog_Stat.begin("Building page list\n");
-   buildPageList(rootNav);
-   Doxy_Globals::infoLog_Stat.end();
+   Doxy_Globals::infoLog_Stat.begin("Building page list and searching for main page\n");
+
+   {
+      // both passes visit the main page in one walk
+      EntryPassList passList;
+      passList.addPass({Entry::PAGEDOC_SEC, Entry::MAINPAGEDOC_SEC}, buildPageList);
+      passList.addPass({Entry::MAINPAGEDOC_SEC}, findMainPage);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
+
+   {
+      // requires the main page of this project
+      EntryPassList passList;
+      passList.addPass({Entry::MAINPAGEDOC_SEC}, findMainPageTagFiles);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
 
-   Doxy_Globals::infoLog_Stat.begin("Search for main page\n");
-   findMainPage(rootNav);
-   findMainPageTagFiles(rootNav);
    Doxy_Globals::infoLog_Stat.end();
 
    Doxy_Globals::infoLog_Stat.begin("Computing page relations\n");
-   computePageRelations(rootNav);
+
+   {
+      EntryPassList passList;
+      passList.addPass({Entry::PAGEDOC_SEC, Entry::MAINPAGEDOC_SEC}, computePageRelations);
+      passList.run(sectionIndex, Doxy_Globals::fileStorage);
+   }
+
    checkPageRelations();
    Doxy_Globals::infoLog_Stat.end();
 
@@ -779,6 +832,11 @@ void processFiles()
    Doxy_Globals::infoLog_Stat.end();
 
    msg("Freeing entry tree\n");
+   EntryNav::addCacheStatistics();
+   EntryNav::clearCache();
+   StringPool::addStatistics();
+   addCanonicalTypeStatistics();
+
    rootNav = QSharedPointer<EntryNav>();
 
    Doxy_Globals::fileStorage.close();
@@ -879,6 +937,9 @@ void processFiles()
    Doxy_Globals::infoLog_Stat.begin("Adding members to index pages\n");
    addMembersToIndex();
    Doxy_Globals::infoLog_Stat.end();
+
+   // all relations are known, references can be resolved once
+   enableResolveCache();
 }
 
 void generateOutput()
@@ -1246,7 +1307,10 @@ void generateOutput()
       Doxy_Globals::infoLog_Stat.end();
    }
 
-   msg("Lookup cache used %d/%d \n", Doxy_Globals::lookupCache.count(), Doxy_Globals::lookupCache.size());
+   msg("Lookup cache used %d/%d \n", Doxy_Globals::lookupCache.count(), Doxy_Globals::lookupCache.maxSize());
+   addResolveCacheStatistics();
+   addArgumentListStatistics();
+   addFuncDeclStatistics();
 
    if (Debug::isFlagSet(Debug::Time)) {
       Doxy_Globals::infoLog_Stat.print();
@@ -4407,13 +4471,13 @@ void Doxy_Work::buildFunctionList(QSharedPointer<EntryNav> rootNav)
                         // merge documentation
                         if (item->documentation().isEmpty() && ! root->doc.isEmpty()) {
 
-                           const ArgumentList &argList = stringToArgumentList(root->args);
+                           ArgumentList argList = stringToArgumentList(root->args);
 
                            if (root->proto) {
-                              item->setDeclArgumentList(argList);
+                              item->setDeclArgumentList(std::move(argList));
 
                            } else {
-                              item->setArgumentList(argList);
+                              item->setArgumentList(std::move(argList));
 
                            }
                         }
@@ -6285,10 +6349,10 @@ ArgumentList Doxy_Work::substituteTemplatesInArgList(const QVector<ArgumentList>
       QString dstArray = substituteTemplatesInString(srcTempArgLists, dstTempArgLists, funcTemplateArgList, sa.array);
 
       Argument arg = sa;
-      arg.type  = dstType;
-      arg.array = dstArray;
+      arg.type  = std::move(dstType);
+      arg.array = std::move(dstArray);
 
-      retval.append(arg);
+      retval.append(std::move(arg));
    }
 
    retval.constSpecifier     = srcList.constSpecifier;
@@ -6641,6 +6705,15 @@ void Doxy_Work::findMember(QSharedPointer<EntryNav> rootNav, QString funcDecl, b
                   if (cd && tcd == cd) {
                      // found the class this funcDecl belongs to
 
+                     // functions with a different number of arguments or other qualifiers can not match,
+                     // skip the template substitution and the argument matching for these overloads
+                     bool canMatch = md->isVariable() || md->isTypedef() || ! funcTempList.isEmpty() ||
+                           md->getArgumentList().sameShape(root->argList, true);
+
+                     if (! canMatch && ! Debug::isFlagSet(Debug::Overloads)) {
+                        continue;
+                     }
+
                      Debug::print(Debug::FindMembers, 0, "\nDebug: findMember() [4] class definition: %s\n",
                         csPrintable(cd->name()));
 
@@ -6799,6 +6872,13 @@ void Doxy_Work::findMember(QSharedPointer<EntryNav> rootNav, QString funcDecl, b
                         }
                      }
 
+                     if (matching && ! canMatch) {
+                        // verify the overloads which are skipped
+                        Debug::print(Debug::Overloads, 0, "findMember: %s%s in %s matches %s, but its arguments differ in "
+                              "number or qualifiers\n", csPrintable(md->name()), csPrintable(argListToString(argList, true)),
+                              csPrintable(cd->name()), csPrintable(argListToString(root->argList, true)));
+                     }
+
                      if (matching) {
                         ArgumentList tmp;
                         addMemberDocs(rootNav, md, funcDecl, tmp, overloaded, nullptr);
@@ -8672,7 +8752,9 @@ void Doxy_Work::flushCachedTemplateRelations()
    // to this class. Optimization: only remove those classes that
    // have inheritance instances as direct or indirect sub classes.
 
-   Doxy_Globals::lookupCache.clear();
+   Doxy_Globals::lookupCache.removeResolved();
+   clearCanonicalTypeCache();
+   clearLookupNameCache();
 
    // remove all cached typedef resolutions whose target is a
    // template class as this may now be a template instance
@@ -8722,7 +8804,9 @@ void Doxy_Work::flushUnresolvedRelations()
    // class B : public A {};
    // class C : public B::I {};
 
-   Doxy_Globals::lookupCache.clear();
+   Doxy_Globals::lookupCache.removeUnresolved();
+   clearCanonicalTypeCache();
+   clearLookupNameCache();
 
    for (auto fn : Doxy_Globals::functionNameSDict) {
       // for each global function name
@@ -8743,52 +8827,87 @@ void Doxy_Work::flushUnresolvedRelations()
    }
 }
 
+// called for DEFINEDOC_SEC and DEFINE_SEC entries
 void Doxy_Work::findDefineDocumentation(QSharedPointer<EntryNav> rootNav)
 {
-   if ((rootNav->section() == Entry::DEFINEDOC_SEC ||
-         rootNav->section() == Entry::DEFINE_SEC) && !rootNav->name().isEmpty()) {
+   if (rootNav->name().isEmpty()) {
+      return;
+   }
 
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
+   QSharedPointer<Entry> root = rootNav->entry();
 
-      if (! rootNav->tagInfo().isEmpty() && ! root->name.isEmpty()) {
+   if (! rootNav->tagInfo().isEmpty() && ! root->name.isEmpty()) {
 
-         // define read from a tag file
-         QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(rootNav->tagInfo().tagName,
-                  1, 1, "#define", root->name, root->args, "",
-                  Public, Normal, false, Member, MemberType_Define, ArgumentList(), ArgumentList());
+      // define read from a tag file
+      QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(rootNav->tagInfo().tagName,
+               1, 1, "#define", root->name, root->args, "",
+               Public, Normal, false, Member, MemberType_Define, ArgumentList(), ArgumentList());
 
-         md->setTagInfo(rootNav->tagInfo());
-         md->setLanguage(root->lang);
-         md->setFileDef(rootNav->parent()->fileDef());
+      md->setTagInfo(rootNav->tagInfo());
+      md->setLanguage(root->lang);
+      md->setFileDef(rootNav->parent()->fileDef());
 
-         QSharedPointer<MemberName> mn;
+      QSharedPointer<MemberName> mn;
 
-         if ((mn = Doxy_Globals::functionNameSDict.find(root->name))) {
-            mn->append(md);
+      if ((mn = Doxy_Globals::functionNameSDict.find(root->name))) {
+         mn->append(md);
 
-         } else {
-            mn = QMakeShared<MemberName>(root->name);
+      } else {
+         mn = QMakeShared<MemberName>(root->name);
 
-            mn->append(md);
-            Doxy_Globals::functionNameSDict.insert(root->name, mn);
-         }
+         mn->append(md);
+         Doxy_Globals::functionNameSDict.insert(root->name, mn);
       }
+   }
 
-      QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict.find(root->name);
+   QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict.find(root->name);
 
-      if (mn) {
-         int count = 0;
+   if (mn) {
+      int count = 0;
+
+      for (auto md : *mn) {
+         if (md->memberType() == MemberType_Define) {
+            count++;
+         }
+      }
 
+      if (count == 1) {
          for (auto md : *mn) {
             if (md->memberType() == MemberType_Define) {
-               count++;
+               md->setDocumentation(root->doc, root->docFile, root->docLine);
+               md->setDocsForDefinition(!root->proto);
+               md->setBriefDescription(root->brief, root->briefFile, root->briefLine);
+
+               if (md->inbodyDocumentation().isEmpty()) {
+                  md->setInbodyDocumentation(root->inbodyDocs, root->inbodyFile, root->inbodyLine);
+               }
+
+               md->setBodySegment(root->bodyLine, root->endBodyLine);
+               md->setBodyDef(rootNav->fileDef());
+               md->addSectionsToDefinition(root->m_anchors);
+               md->setMaxInitLines(root->initLines);
+               md->setRefItems(root->m_specialLists);
+
+               if (root->mGrpId != -1) {
+                  md->setMemberGroupId(root->mGrpId);
+               }
+
+               addMemberToGroups(root, md);
             }
          }
 
-         if (count == 1) {
-            for (auto md : *mn) {
-               if (md->memberType() == MemberType_Define) {
+      } else if (count > 1 && (! root->doc.isEmpty() || !root->brief.isEmpty() || root->bodyLine != -1))
+         // multiple defines don't know where to add docs
+         // but maybe they are in different files together with their documentation
+
+         for (auto md : *mn) {
+
+            if (md->memberType() == MemberType_Define) {
+               QSharedPointer<FileDef> fd = md->getFileDef();
+
+               if (fd && fd->getFilePath() == root->fileName) {
+                  // doc and define in the same file assume they belong together.
+
                   md->setDocumentation(root->doc, root->docFile, root->docLine);
                   md->setDocsForDefinition(!root->proto);
                   md->setBriefDescription(root->brief, root->briefFile, root->briefLine);
@@ -8800,8 +8919,8 @@ void Doxy_Work::findDefineDocumentation(QSharedPointer<EntryNav> rootNav)
                   md->setBodySegment(root->bodyLine, root->endBodyLine);
                   md->setBodyDef(rootNav->fileDef());
                   md->addSectionsToDefinition(root->m_anchors);
-                  md->setMaxInitLines(root->initLines);
                   md->setRefItems(root->m_specialLists);
+                  md->setLanguage(root->lang);
 
                   if (root->mGrpId != -1) {
                      md->setMemberGroupId(root->mGrpId);
@@ -8810,138 +8929,87 @@ void Doxy_Work::findDefineDocumentation(QSharedPointer<EntryNav> rootNav)
                   addMemberToGroups(root, md);
                }
             }
+         }
 
-         } else if (count > 1 && (! root->doc.isEmpty() || !root->brief.isEmpty() || root->bodyLine != -1))
-            // multiple defines don't know where to add docs
-            // but maybe they are in different files together with their documentation
-
-            for (auto md : *mn) {
-
-               if (md->memberType() == MemberType_Define) {
-                  QSharedPointer<FileDef> fd = md->getFileDef();
-
-                  if (fd && fd->getFilePath() == root->fileName) {
-                     // doc and define in the same file assume they belong together.
-
-                     md->setDocumentation(root->doc, root->docFile, root->docLine);
-                     md->setDocsForDefinition(!root->proto);
-                     md->setBriefDescription(root->brief, root->briefFile, root->briefLine);
-
-                     if (md->inbodyDocumentation().isEmpty()) {
-                        md->setInbodyDocumentation(root->inbodyDocs, root->inbodyFile, root->inbodyLine);
-                     }
-
-                     md->setBodySegment(root->bodyLine, root->endBodyLine);
-                     md->setBodyDef(rootNav->fileDef());
-                     md->addSectionsToDefinition(root->m_anchors);
-                     md->setRefItems(root->m_specialLists);
-                     md->setLanguage(root->lang);
-
-                     if (root->mGrpId != -1) {
-                        md->setMemberGroupId(root->mGrpId);
-                     }
-
-                     addMemberToGroups(root, md);
-                  }
-               }
-            }
-
-      } else if (!root->doc.isEmpty() || !root->brief.isEmpty()) { // define not found
-         static bool preEnabled = Config::getBool("enable-preprocessing");
+   } else if (!root->doc.isEmpty() || !root->brief.isEmpty()) { // define not found
+      static bool preEnabled = Config::getBool("enable-preprocessing");
 
-         if (preEnabled) {
-            warn(root->fileName, root->startLine, "documentation for unknown define %s found.\n",
-                  csPrintable(root->name) );
+      if (preEnabled) {
+         warn(root->fileName, root->startLine, "documentation for unknown define %s found.\n",
+               csPrintable(root->name) );
 
-         } else {
-            warn(root->fileName, root->startLine, "found documented #define, ignoring since "
-                 "ENABLE PREPROCESSING tag is not set\n",  csPrintable(root->name) );
-         }
+      } else {
+         warn(root->fileName, root->startLine, "found documented #define, ignoring since "
+              "ENABLE PREPROCESSING tag is not set\n",  csPrintable(root->name) );
       }
-
-      rootNav->releaseEntry();
    }
-
-   RECURSE_ENTRYTREE(findDefineDocumentation, rootNav);
 }
 
+// called for DIRDOC_SEC entries
 void Doxy_Work::findDirDocumentation(QSharedPointer<EntryNav> rootNav)
 {
-   if (rootNav->section() == Entry::DIRDOC_SEC) {
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
+   QSharedPointer<Entry> root = rootNav->entry();
 
-      QString normalizedName = root->name;
-      normalizedName = substitute(normalizedName, "\\", "/");
+   QString normalizedName = root->name;
+   normalizedName = substitute(normalizedName, "\\", "/");
 
-      if (root->docFile == normalizedName) { // current dir?
-         int lastSlashPos = normalizedName.lastIndexOf('/');
+   if (root->docFile == normalizedName) { // current dir?
+      int lastSlashPos = normalizedName.lastIndexOf('/');
 
-         if (lastSlashPos != -1) { // strip file name
-            normalizedName = normalizedName.left(lastSlashPos);
-         }
+      if (lastSlashPos != -1) { // strip file name
+         normalizedName = normalizedName.left(lastSlashPos);
       }
+   }
 
-      if (normalizedName.at(normalizedName.length() - 1) != '/') {
-         normalizedName += '/';
-      }
+   if (normalizedName.at(normalizedName.length() - 1) != '/') {
+      normalizedName += '/';
+   }
 
-      QSharedPointer<DirDef> matchingDir;
+   QSharedPointer<DirDef> matchingDir;
 
-      for (auto dir : Doxy_Globals::directories) {
+   for (auto dir : Doxy_Globals::directories) {
 
-         if (dir->name().right(normalizedName.length()) == normalizedName) {
-            if (matchingDir) {
+      if (dir->name().right(normalizedName.length()) == normalizedName) {
+         if (matchingDir) {
 
-               warn(root->fileName, root->startLine, "\\dir command matches multiple directories.\n"
-                    "  Applying the command for directory %s\n"
-                    "  Ignoring the command for directory %s\n", csPrintable(matchingDir->name()),
-                    csPrintable(dir->name()) );
+            warn(root->fileName, root->startLine, "\\dir command matches multiple directories.\n"
+                 "  Applying the command for directory %s\n"
+                 "  Ignoring the command for directory %s\n", csPrintable(matchingDir->name()),
+                 csPrintable(dir->name()) );
 
-            } else {
-               matchingDir = dir;
+         } else {
+            matchingDir = dir;
 
-            }
          }
       }
+   }
 
-      if (matchingDir) {
-         matchingDir->setBriefDescription(root->brief, root->briefFile, root->briefLine);
-         matchingDir->setDocumentation(root->doc, root->docFile, root->docLine);
-         matchingDir->setRefItems(root->m_specialLists);
-
-         addDirToGroups(root, matchingDir);
+   if (matchingDir) {
+      matchingDir->setBriefDescription(root->brief, root->briefFile, root->briefLine);
+      matchingDir->setDocumentation(root->doc, root->docFile, root->docLine);
+      matchingDir->setRefItems(root->m_specialLists);
 
-      } else {
-         warn(root->fileName, root->startLine, "No matching "
-              "directory found for command \\dir %s\n",  csPrintable(normalizedName));
-      }
+      addDirToGroups(root, matchingDir);
 
-      rootNav->releaseEntry();
+   } else {
+      warn(root->fileName, root->startLine, "No matching "
+           "directory found for command \\dir %s\n",  csPrintable(normalizedName));
    }
-
-   RECURSE_ENTRYTREE(findDirDocumentation, rootNav);
 }
 
-// create a (sorted) list of separate documentation pages
+// create a (sorted) list of separate documentation pages, called for PAGEDOC_SEC and MAINPAGEDOC_SEC entries
 void Doxy_Work::buildPageList(QSharedPointer<EntryNav> rootNav)
 {
-   if (rootNav->section() == Entry::PAGEDOC_SEC) {
+   QSharedPointer<Entry> root = rootNav->entry();
 
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
+   if (rootNav->section() == Entry::PAGEDOC_SEC) {
 
       if (! root->name.isEmpty()) {
          addRelatedPage_X(rootNav);
       }
 
-      rootNav->releaseEntry();
-
    } else if (rootNav->section() == Entry::MAINPAGEDOC_SEC) {
 
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
-
       QString title = root->args.trimmed();
 
       if (title.isEmpty()) {
@@ -8950,119 +9018,94 @@ void Doxy_Work::buildPageList(QSharedPointer<EntryNav> rootNav)
 
       QString name = "index";
       addRefItem(root->m_specialLists, name, "page", name, title, "", QSharedPointer<Definition>());
-
-      rootNav->releaseEntry();
-   }
-
-   // recursive call
-   for (auto item : rootNav->children() ) {
-      buildPageList(item);
    }
 }
 
-// search for \mainpage defined in this project
+// search for \mainpage defined in this project, called for MAINPAGEDOC_SEC entries
 void Doxy_Work::findMainPage(QSharedPointer<EntryNav> rootNav)
 {
+   if (Doxy_Globals::mainPage == nullptr && rootNav->tagInfo().isEmpty()) {
+      QSharedPointer<Entry> root = rootNav->entry();
 
-   if (rootNav->section() == Entry::MAINPAGEDOC_SEC) {
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-
-      if (Doxy_Globals::mainPage == nullptr && rootNav->tagInfo().isEmpty()) {
-         QSharedPointer<Entry> root = rootNav->entry();
-
-         QString title = root->args.trimmed();
+      QString title = root->args.trimmed();
 
-         QString indexName = "index";
-         Doxy_Globals::mainPage = QMakeShared<PageDef>(root->docFile, root->docLine,
-                                         indexName, root->brief + root->doc + root->inbodyDocs, title);
+      QString indexName = "index";
+      Doxy_Globals::mainPage = QMakeShared<PageDef>(root->docFile, root->docLine,
+                                      indexName, root->brief + root->doc + root->inbodyDocs, title);
 
-         Doxy_Globals::mainPage->setBriefDescription(root->brief, root->briefFile, root->briefLine);
-         Doxy_Globals::mainPage->setFileName(indexName);
-         Doxy_Globals::mainPage->setShowToc(root->stat);
+      Doxy_Globals::mainPage->setBriefDescription(root->brief, root->briefFile, root->briefLine);
+      Doxy_Globals::mainPage->setFileName(indexName);
+      Doxy_Globals::mainPage->setShowToc(root->stat);
 
-         addPageToContext(Doxy_Globals::mainPage, rootNav);
+      addPageToContext(Doxy_Globals::mainPage, rootNav);
 
-         QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(Doxy_Globals::mainPage->name());
+      QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(Doxy_Globals::mainPage->name());
 
-         if (si) {
-            if (si->lineNr != -1) {
-               warn(root->fileName, root->startLine, "multiple use of section label '%s' for main page, "
-                  "(first occurrence: %s, line %d)", csPrintable(Doxy_Globals::mainPage->name()),
-                   csPrintable(si->fileName), si->lineNr);
-
-            } else {
-               warn(root->fileName, root->startLine, "multiple use of section label '%s' for main page, (first occurrence: %s)",
-                    csPrintable(Doxy_Globals::mainPage->name()), csPrintable(si->fileName));
-            }
+      if (si) {
+         if (si->lineNr != -1) {
+            warn(root->fileName, root->startLine, "multiple use of section label '%s' for main page, "
+               "(first occurrence: %s, line %d)", csPrintable(Doxy_Globals::mainPage->name()),
+                csPrintable(si->fileName), si->lineNr);
 
          } else {
-            // a page name is a label as well, but should not be double either
-            si = QMakeShared<SectionInfo>(indexName, root->startLine, Doxy_Globals::mainPage->name(),
-                              Doxy_Globals::mainPage->title(), SectionInfo::Page, 0);
-
-            Doxy_Globals::sectionDict.insert(indexName, si);
-            Doxy_Globals::mainPage->addSectionsToDefinition(root->m_anchors);
+            warn(root->fileName, root->startLine, "multiple use of section label '%s' for main page, (first occurrence: %s)",
+                 csPrintable(Doxy_Globals::mainPage->name()), csPrintable(si->fileName));
          }
 
-      } else if (rootNav->tagInfo().isEmpty()) {
-         QSharedPointer<Entry> root = rootNav->entry();
+      } else {
+         // a page name is a label as well, but should not be double either
+         si = QMakeShared<SectionInfo>(indexName, root->startLine, Doxy_Globals::mainPage->name(),
+                           Doxy_Globals::mainPage->title(), SectionInfo::Page, 0);
 
-         warn(root->fileName, root->startLine, "Found more than one \\mainpage comment block "
-            "(first occurrence: %s, line %d), Skip current block",
-            csPrintable(Doxy_Globals::mainPage->docFile()), Doxy_Globals::mainPage->docLine());
+         Doxy_Globals::sectionDict.insert(indexName, si);
+         Doxy_Globals::mainPage->addSectionsToDefinition(root->m_anchors);
       }
 
-      rootNav->releaseEntry();
-   }
+   } else if (rootNav->tagInfo().isEmpty()) {
+      QSharedPointer<Entry> root = rootNav->entry();
 
-   RECURSE_ENTRYTREE(findMainPage, rootNav);
+      warn(root->fileName, root->startLine, "Found more than one \\mainpage comment block "
+         "(first occurrence: %s, line %d), Skip current block",
+         csPrintable(Doxy_Globals::mainPage->docFile()), Doxy_Globals::mainPage->docLine());
+   }
 }
 
-// search for the main page imported via tag files and add only the section labels
+// search for the main page imported via tag files and add only the section labels, called for MAINPAGEDOC_SEC entries
 void Doxy_Work::findMainPageTagFiles(QSharedPointer<EntryNav> rootNav)
 {
-   if (rootNav->section() == Entry::MAINPAGEDOC_SEC) {
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-
-      if (Doxy_Globals::mainPage && ! rootNav->tagInfo().isEmpty() ) {
-         QSharedPointer<Entry> root = rootNav->entry();
-         Doxy_Globals::mainPage->addSectionsToDefinition(root->m_anchors);
-      }
+   if (Doxy_Globals::mainPage && ! rootNav->tagInfo().isEmpty() ) {
+      QSharedPointer<Entry> root = rootNav->entry();
+      Doxy_Globals::mainPage->addSectionsToDefinition(root->m_anchors);
    }
-   RECURSE_ENTRYTREE(findMainPageTagFiles, rootNav);
 }
 
+// called for PAGEDOC_SEC and MAINPAGEDOC_SEC entries
 void Doxy_Work::computePageRelations(QSharedPointer<EntryNav> rootNav)
 {
-   if ((rootNav->section() == Entry::PAGEDOC_SEC || rootNav->section() == Entry::MAINPAGEDOC_SEC)
-               && !rootNav->name().isEmpty() ) {
+   if (rootNav->name().isEmpty()) {
+      return;
+   }
 
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
+   QSharedPointer<Entry> root = rootNav->entry();
 
-      QSharedPointer<PageDef> pd;
+   QSharedPointer<PageDef> pd;
 
-      if (root->section == Entry::PAGEDOC_SEC) {
-         pd = Doxy_Globals::pageSDict.find(root->name);
-      } else {
-         pd = Doxy_Globals::mainPage;
-      }
+   if (root->section == Entry::PAGEDOC_SEC) {
+      pd = Doxy_Globals::pageSDict.find(root->name);
+   } else {
+      pd = Doxy_Globals::mainPage;
+   }
 
-      if (pd) {
+   if (pd) {
 
-         for (auto bi : root->extends) {
-            QSharedPointer<PageDef> subPd = Doxy_Globals::pageSDict.find(bi.name);
+      for (auto bi : root->extends) {
+         QSharedPointer<PageDef> subPd = Doxy_Globals::pageSDict.find(bi.name);
 
-            if (subPd) {
-               pd->addInnerCompound(subPd);
-            }
+         if (subPd) {
+            pd->addInnerCompound(subPd);
          }
       }
-
-      rootNav->releaseEntry();
    }
-
-   RECURSE_ENTRYTREE(computePageRelations, rootNav);
 }
 
 void Doxy_Work::checkPageRelations()
@@ -9156,32 +9199,30 @@ void Doxy_Work::generatePageDocs()
    }
 }
 
-// create a (sorted) list & dictionary of example pages
+// create a (sorted) list & dictionary of example pages, called for EXAMPLE_SEC entries
 void Doxy_Work::buildExampleList(QSharedPointer<EntryNav> rootNav)
 {
-   if (rootNav->section() == Entry::EXAMPLE_SEC && ! rootNav->name().isEmpty()) {
-      rootNav->loadEntry(Doxy_Globals::fileStorage);
-      QSharedPointer<Entry> root = rootNav->entry();
+   if (rootNav->name().isEmpty()) {
+      return;
+   }
 
-      if (Doxy_Globals::exampleSDict.find(root->name)) {
-         warn(root->fileName, root->startLine, "Example %s was already documented. Ignoring "
-              "documentation found here.", csPrintable(root->name));
+   QSharedPointer<Entry> root = rootNav->entry();
 
-      } else {
-         QSharedPointer<PageDef> pd = QMakeShared<PageDef>(root->fileName, root->startLine,
-                                   root->name, root->brief + root->doc + root->inbodyDocs, root->args);
+   if (Doxy_Globals::exampleSDict.find(root->name)) {
+      warn(root->fileName, root->startLine, "Example %s was already documented. Ignoring "
+           "documentation found here.", csPrintable(root->name));
 
-         pd->setBriefDescription(root->brief, root->briefFile, root->briefLine);
-         pd->setFileName(csPrintable(convertNameToFile_X(pd->name() + "-example", false, true)));
-         pd->addSectionsToDefinition(root->m_anchors);
-         pd->setLanguage(root->lang);
+   } else {
+      QSharedPointer<PageDef> pd = QMakeShared<PageDef>(root->fileName, root->startLine,
+                                root->name, root->brief + root->doc + root->inbodyDocs, root->args);
 
-         Doxy_Globals::exampleSDict.insert(root->name, pd);
-      }
+      pd->setBriefDescription(root->brief, root->briefFile, root->briefLine);
+      pd->setFileName(csPrintable(convertNameToFile_X(pd->name() + "-example", false, true)));
+      pd->addSectionsToDefinition(root->m_anchors);
+      pd->setLanguage(root->lang);
 
-      rootNav->releaseEntry();
+      Doxy_Globals::exampleSDict.insert(root->name, pd);
    }
-   RECURSE_ENTRYTREE(buildExampleList, rootNav);
 }
 
 // print the entry tree (for debugging)
@@ -9451,6 +9492,22 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
       extension = ".no_extension";
    }
 
+   auto srcLang  = fd->getLanguage();
+   bool useClang = clangParsing && (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC);
+
+   QString buffer;
+
+   if (useClang && ClangParser::instance()->takeQueuedSource(fileName, buffer)) {
+      // read and converted when the translation unit was queued for the clang worker threads
+      msg("Reading %s\n", csPrintable(fileName));
+
+      fd->getAllIncludeFilesRecursively(includedFiles);
+      parser->parseInput(fileName, buffer, root, mode, includedFiles, true);
+
+      root->createNavigationIndex(rootNav, Doxy_Globals::fileStorage, fd, root);
+      return;
+   }
+
    QFileInfo fi(fileName);
    QString fileContents;
 
@@ -9472,11 +9529,32 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
       fileContents += '\n';
    }
 
+   ParseCache *parseCache = ParseCache::instance();
+   QByteArray cacheKey;
+
+   if (parseCache->isEnabled()) {
+      // key is based on the preprocessed contents, changes to included files are detected
+      cacheKey = parseCache->computeKey(fileName, mode, fileContents);
+
+      int anonNSDelta = 0;
+      QSharedPointer<Entry> cachedRoot = parseCache->restore(fileName, cacheKey, anonNSDelta);
+
+      if (cachedRoot) {
+         // later files must see the same counter as when this file was parsed
+         Doxy_Globals::anonNSCount += anonNSDelta;
+
+         cachedRoot->createNavigationIndex(rootNav, Doxy_Globals::fileStorage, fd, cachedRoot);
+         return;
+      }
+   }
+
+   int sideEffects = Doxy_Globals::parseSideEffects;
+   int anonNSCount = Doxy_Globals::anonNSCount;
+
    // convert multi-line C++ comments to C style comments
-   QString buffer = convertCppComments(fileContents, fileName);
-   auto srcLang   = fd->getLanguage();
+   buffer = convertCppComments(fileContents, fileName);
 
-   if (clangParsing && (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC)) {
+   if (useClang) {
       fd->getAllIncludeFilesRecursively(includedFiles);
 
       // use clang for parsing
@@ -9488,6 +9566,14 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
 
    }
 
+   if (parseCache->isEnabled()) {
+      if (sideEffects == Doxy_Globals::parseSideEffects) {
+         parseCache->store(fileName, cacheKey, root, Doxy_Globals::anonNSCount - anonNSCount);
+      } else {
+         parseCache->skip(fileName);
+      }
+   }
+
    // this is the code to store the entry tree in the marshaled file, then create an index to navigate/load entries
    root->createNavigationIndex(rootNav, Doxy_Globals::fileStorage, fd, root);
 }
@@ -9502,10 +9588,45 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root, QSharedPointer<EntryNav>
       QSet<QString> processedFiles;
       QSet<QString> filesToProcess;
 
+      // number of threads used to parse the clang translation units, at most 32
+      int numThreads = Config::getInt("parse-num-threads");
+
+      if (numThreads > 32) {
+         warn_uncond("Value of parse-num-threads is %d, only 32 threads will be used\n", numThreads);
+         numThreads = 32;
+      }
+
+      if (numThreads == 0) {
+         numThreads = qMax(2, QThread::idealThreadCount());
+      }
+
       for (auto fName : Doxy_Globals::g_inputFiles) {
          filesToProcess.insert(fName);
       }
 
+      if (numThreads > 1) {
+         // translation units of the source files are parsed by worker threads, in the order used below
+         QVector<QPair<QString, QStringList>> tuList;
+
+         for (auto fName : Doxy_Globals::g_inputFiles) {
+            bool ambig;
+
+            QSharedPointer<FileDef> fd = findFileDef(&Doxy_Globals::inputNameDict, fName, ambig);
+            assert(fd != 0);
+
+            auto srcLang = fd->getLanguage();
+
+            if (fd->isSource() && ! fd->isReference() && (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC)) {
+               QStringList includedFiles;
+               fd->getAllIncludeFilesRecursively(includedFiles);
+
+               tuList.append(qMakePair(fName, includedFiles));
+            }
+         }
+
+         ClangParser::instance()->startWorkers(tuList, numThreads);
+      }
+
       // process source files and their include dependencies
       for (auto fName : Doxy_Globals::g_inputFiles) {
          bool ambig;
@@ -9572,6 +9693,8 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root, QSharedPointer<EntryNav>
          }
       }
 
+      ClangParser::instance()->stopWorkers();
+
    } else  {
       // use lex and not clang
 
@@ -9985,11 +10108,13 @@ void Doxy_Work::dumpGlossary()
    if (f.open(QIODevice::WriteOnly)) {
       QTextStream t(&f);
 
-      for (auto item : Doxy_Globals::glossary()) {
+      for (const auto &symbols : Doxy_Globals::glossary().symbols()) {
          // list of phrases
 
-         QSharedPointer<Definition> def = sharedFrom(item);
-         dumpPhrase(t, def);
+         for (const auto &symbol : symbols) {
+            QSharedPointer<Definition> def = sharedFrom(symbol.def);
+            dumpPhrase(t, def);
+         }
       }
    }
 }
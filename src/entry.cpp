@@ -17,6 +17,7 @@
 
 #include <QFile>
 
+#include <list>
 #include <stdlib.h>
 
 #include <entry.h>
@@ -26,9 +27,10 @@
 #include <filestorage.h>
 #include <marshal.h>
 #include <section.h>
+#include <string_pool.h>
 #include <util.h>
 
-int Entry::m_EntryCount = 0;
+std::atomic<int> Entry::m_EntryCount(0);
 
 Entry::Entry()
 {
@@ -263,8 +265,122 @@ void Entry::removeSubEntry(QSharedPointer<Entry> e)
    }
 }
 
+/** @brief Least recently used cache of the entries decoded by EntryNav::loadEntry()
+ */
+class EntryCache
+{
+ public:
+   EntryCache()
+      : m_hits(0), m_misses(0), m_evictions(0), m_size(0)
+   {
+   }
+
+   static qint64 maxSize() {
+      static const qint64 retval = qint64(qMax(0, Config::getInt("entry-cache-size"))) * 1024 * 1024;
+      return retval;
+   }
+
+   QSharedPointer<Entry> find(int64_t offset);
+   void insert(int64_t offset, QSharedPointer<Entry> e);
+   void clear();
+
+   long m_hits;
+   long m_misses;
+   long m_evictions;
+
+ private:
+   struct CacheItem {
+      int64_t offset;
+      qint64  size;
+      QSharedPointer<Entry> entry;
+   };
+
+   // approximate memory used by an entry
+   static qint64 entrySize(const Entry &e);
+
+   // most recently used entry first
+   std::list<CacheItem> m_lru;
+   QHash<int64_t, std::list<CacheItem>::iterator> m_items;
+
+   qint64 m_size;
+};
+
+static EntryCache s_entryCache;
+
+qint64 EntryCache::entrySize(const Entry &e)
+{
+   qint64 retval = sizeof(Entry);
+
+   for (const QString *str : { &e.type, &e.name, &e.args, &e.bitfields, &e.m_program, &e.initializer,
+            &e.includeFile, &e.includeName, &e.doc, &e.docFile, &e.brief, &e.briefFile, &e.inbodyDocs,
+            &e.inbodyFile, &e.relates, &e.inside, &e.exception, &e.fileName, &e.id } ) {
+
+      retval += str->size() * sizeof(QChar);
+   }
+
+   retval += e.argList.size() * sizeof(Argument);
+
+   for (const auto &item : e.m_templateArgLists) {
+      retval += sizeof(ArgumentList) + item.size() * sizeof(Argument);
+   }
+
+   retval += e.extends.size() * sizeof(BaseInfo) + e.m_groups.size() * sizeof(Grouping) +
+             e.m_anchors.size() * sizeof(SectionInfo) + e.m_specialLists.size() * sizeof(ListItemInfo);
+
+   return retval;
+}
+
+QSharedPointer<Entry> EntryCache::find(int64_t offset)
+{
+   auto iter = m_items.find(offset);
+
+   if (iter == m_items.end()) {
+      ++m_misses;
+      return QSharedPointer<Entry>();
+   }
+
+   ++m_hits;
+
+   // move to the front
+   m_lru.splice(m_lru.begin(), m_lru, iter.value());
+
+   return iter.value()->entry;
+}
+
+void EntryCache::insert(int64_t offset, QSharedPointer<Entry> e)
+{
+   qint64 size = entrySize(*e);
+
+   if (size > maxSize() || m_items.contains(offset)) {
+      return;
+   }
+
+   while (m_size + size > maxSize() && ! m_lru.empty()) {
+      // remove the least recently used entry
+      const CacheItem &item = m_lru.back();
+
+      m_size -= item.size;
+      m_items.remove(item.offset);
+      m_lru.pop_back();
+
+      ++m_evictions;
+   }
+
+   m_lru.push_front(CacheItem{offset, size, e});
+   m_items.insert(offset, m_lru.begin());
+
+   m_size += size;
+}
+
+void EntryCache::clear()
+{
+   m_items.clear();
+   m_lru.clear();
+   m_size = 0;
+}
+
 EntryNav::EntryNav(QSharedPointer<EntryNav> parent, QSharedPointer<Entry> e)
-   : m_parent(parent), m_section(e->section), m_type(e->type), m_name(e->name),
+   : m_parent(parent), m_section(e->section), m_type(StringPool::intern(e->type)), m_name(StringPool::intern(e->name)),
      m_fileDef(0), m_lang(e->lang), m_offset(-1), m_noLoad(false)
 {
 
@@ -290,11 +406,37 @@ bool EntryNav::loadEntry(FileStorage &storage)
       return false;
    }
 
-   if (! storage.seek(m_offset)) {
-      return false;
-   }
+   if (EntryCache::maxSize() > 0) {
+      QSharedPointer<Entry> cachedEntry = s_entryCache.find(m_offset);
 
-   m_info = unmarshalEntry(&storage);
+      if (! cachedEntry) {
+         if (! storage.seek(m_offset)) {
+            return false;
+         }
+
+         cachedEntry = unmarshalEntry(&storage);
+
+         if (! cachedEntry) {
+            return false;
+         }
+
+         s_entryCache.insert(m_offset, cachedEntry);
+      }
+
+      // passes may modify the loaded entry, changes must not be visible after it was released
+      m_info = QMakeShared<Entry>(*cachedEntry);
+
+   } else {
+      if (! storage.seek(m_offset)) {
+         return false;
+      }
+
+      m_info = unmarshalEntry(&storage);
+
+      if (! m_info) {
+         return false;
+      }
+   }
 
    m_info->name    = m_name;
    m_info->type    = m_type;
@@ -318,6 +460,24 @@ void EntryNav::releaseEntry()
    }
 }
 
+void EntryNav::addCacheStatistics()
+{
+   if (EntryCache::maxSize() > 0) {
+      long total = s_entryCache.m_hits + s_entryCache.m_misses;
+
+      Doxy_Globals::infoLog_Stat.addCounter("entries loaded from the entry cache",  s_entryCache.m_hits);
+      Doxy_Globals::infoLog_Stat.addCounter("entries decoded from storage",        s_entryCache.m_misses);
+      Doxy_Globals::infoLog_Stat.addCounter("entries evicted from the entry cache", s_entryCache.m_evictions);
+      Doxy_Globals::infoLog_Stat.addCounter("entry cache hit rate (percent)",
+                  total > 0 ? (s_entryCache.m_hits * 100) / total : 0);
+   }
+}
+
+void EntryNav::clearCache()
+{
+   s_entryCache.clear();
+}
+
 void EntryNav::setEntry(QSharedPointer<Entry> e)
 {
    m_info   = e;
@@ -18,6 +18,7 @@
 #ifndef ENTRY_H
 #define ENTRY_H
 
+#include <atomic>
 #include <bitset>
 
 #include <QString>
@@ -244,6 +245,17 @@ class Entry
             return retval;
          }
 
+         // number of 64 bit words used by marshal
+         static constexpr int numWords = (Virtue::LastVirtue + 63) / 64;
+
+         uint64_t toWord(int index) const {
+            return ((m_flags >> (64 * index)) & std::bitset<Virtue::LastVirtue>(~0ULL)).to_ullong();
+         }
+
+         void setWord(int index, uint64_t value)  {
+            m_flags |= std::bitset<Virtue::LastVirtue>(value) << (64 * index);
+         }
+
          void clear()  {
             m_flags.reset();
          }
@@ -315,7 +327,7 @@ class Entry
 
    Traits m_traits;
 
-   static int m_EntryCount;        // counts the total number of entries
+   static std::atomic<int> m_EntryCount;   // counts the total number of entries, updated from several threads
 
    int  section;                   // entry type (see Sections);
    int  initLines;                 // define/variable initializer lines to show
@@ -441,6 +453,10 @@ class EntryNav
    void setEntry(QSharedPointer<Entry> e);
    void releaseEntry();
 
+   // loaded entries are kept in a cache of entry-cache-size MB
+   static void addCacheStatistics();
+   static void clearCache();
+
    void changeSection(int section) {
       m_section = section;
    }
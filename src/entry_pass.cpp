@@ -0,0 +1,110 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <algorithm>
+
+#include <entry_pass.h>
+
+#include <entry.h>
+#include <filestorage.h>
+
+EntrySectionIndex::EntrySectionIndex(QSharedPointer<EntryNav> rootNav)
+   : m_count(0)
+{
+   if (rootNav) {
+      addEntry(rootNav);
+   }
+}
+
+void EntrySectionIndex::addEntry(QSharedPointer<EntryNav> nav)
+{
+   m_sections[nav->section()].append(IndexItem{m_count, nav});
+   ++m_count;
+
+   for (auto item : nav->children()) {
+      addEntry(item);
+   }
+}
+
+QVector<QSharedPointer<EntryNav>> EntrySectionIndex::entries(const QVector<int> &sections) const
+{
+   QVector<IndexItem> items;
+
+   for (int section : sections) {
+      auto iter = m_sections.constFind(section);
+
+      if (iter == m_sections.constEnd()) {
+         continue;
+      }
+
+      for (const auto &item : iter.value()) {
+         // passes only ever move a node to EMPTY_SEC, skip nodes which were handled already
+         if (item.nav->section() == section) {
+            items.append(item);
+         }
+      }
+   }
+
+   if (sections.size() > 1) {
+      std::sort(items.begin(), items.end(), [](const IndexItem &a, const IndexItem &b) {
+         return a.position < b.position;
+      });
+   }
+
+   QVector<QSharedPointer<EntryNav>> retval;
+   retval.reserve(items.size());
+
+   for (const auto &item : items) {
+      retval.append(item.nav);
+   }
+
+   return retval;
+}
+
+void EntryPassList::addPass(const QVector<int> &sections, Visitor visitor)
+{
+   m_passes.append(Pass{sections, visitor});
+}
+
+void EntryPassList::run(const EntrySectionIndex &index, FileStorage &storage) const
+{
+   QVector<int> allSections;
+
+   for (const auto &pass : m_passes) {
+      for (int section : pass.sections) {
+         if (! allSections.contains(section)) {
+            allSections.append(section);
+         }
+      }
+   }
+
+   for (auto nav : index.entries(allSections)) {
+      int section = nav->section();
+
+      if (! nav->loadEntry(storage)) {
+         continue;
+      }
+
+      for (const auto &pass : m_passes) {
+         if (pass.sections.contains(section)) {
+            pass.visitor(nav);
+         }
+      }
+
+      nav->releaseEntry();
+   }
+}
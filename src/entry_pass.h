@@ -0,0 +1,81 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef ENTRY_PASS_H
+#define ENTRY_PASS_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <functional>
+
+class EntryNav;
+class FileStorage;
+
+/** \brief Index of the entry navigation tree grouped by section
+ *
+ *  The tree is walked once and every node is recorded under its section together with its
+ *  position in a depth first walk. Passes which only handle a few section kinds can then
+ *  visit the matching nodes directly, in the same order a recursive walk would visit them.
+ */
+class EntrySectionIndex
+{
+ public:
+   EntrySectionIndex(QSharedPointer<EntryNav> rootNav);
+
+   // nodes which still have one of the given sections, in tree order
+   QVector<QSharedPointer<EntryNav>> entries(const QVector<int> &sections) const;
+
+ private:
+   struct IndexItem {
+      int position;
+      QSharedPointer<EntryNav> nav;
+   };
+
+   void addEntry(QSharedPointer<EntryNav> nav);
+
+   QHash<int, QVector<IndexItem>> m_sections;
+   int m_count;
+};
+
+/** \brief Runs a group of independent passes over the entry tree in one walk
+ *
+ *  Each pass names the sections it handles and a visitor which is called with the entry of
+ *  the node loaded. The entry of a node is loaded and released once, no matter how many passes
+ *  handle it. Passes in one list must not depend on each other's results since the visitors
+ *  are interleaved node by node.
+ */
+class EntryPassList
+{
+ public:
+   using Visitor = std::function<void (QSharedPointer<EntryNav>)>;
+
+   void addPass(const QVector<int> &sections, Visitor visitor);
+
+   void run(const EntrySectionIndex &index, FileStorage &storage) const;
+
+ private:
+   struct Pass {
+      QVector<int> sections;
+      Visitor visitor;
+   };
+
+   QVector<Pass> m_passes;
+};
+
+#endif
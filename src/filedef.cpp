@@ -1159,6 +1159,7 @@ void FileDef::addUsingDirective(QSharedPointer<NamespaceDef> nd)
 {
    if (! m_usingDirList.find(nd->qualifiedName()) ) {
       m_usingDirList.insert(nd->qualifiedName(), nd);
+      invalidateAccessIndex();
    }
 }
 
@@ -1171,6 +1172,7 @@ void FileDef::addUsingDeclaration(QSharedPointer<Definition> d)
 {
    if (! m_usingDeclList.find(d->qualifiedName()) ) {
       m_usingDeclList.insert(d->qualifiedName(), d);
+      invalidateAccessIndex();
    }
 }
 
@@ -0,0 +1,163 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <filestorage.h>
+
+#include <marshal.h>
+
+#define STRING_TABLE_MAGIC   ('D'<<24)+('X'<<16)+('S'<<8)+'T'
+#define STRING_TABLE_VERSION 1
+
+// size of the trailer which locates the string table, offset (8 bytes), magic and version (4 bytes each)
+static const int TRAILER_SIZE = 16;
+
+// longer strings are rarely repeated and are written in full
+static const int MAX_SHARED_STRING = 128;
+
+static void putBigEndian(uchar *buffer, uint64_t value, int size)
+{
+   for (int i = size - 1; i >= 0; --i) {
+      buffer[i] = value & 0xff;
+      value >>= 8;
+   }
+}
+
+static uint64_t getBigEndian(const uchar *buffer, int size)
+{
+   uint64_t retval = 0;
+
+   for (int i = 0; i < size; ++i) {
+      retval = (retval << 8) | buffer[i];
+   }
+
+   return retval;
+}
+
+int FileStorage::internString(const QString &str)
+{
+   if (m_readOnly || str.isEmpty() || str.size() > MAX_SHARED_STRING) {
+      return -1;
+   }
+
+   auto iter = m_stringIndex.find(str);
+
+   if (iter != m_stringIndex.end()) {
+      return iter.value();
+   }
+
+   int index = m_strings.size();
+
+   m_strings.append(str);
+   m_stringIndex.insert(str, index);
+
+   return index;
+}
+
+bool FileStorage::open(QIODevice::OpenModeFlag value)
+{
+   m_readOnly = (value == QIODevice::ReadOnly);
+
+   m_strings.clear();
+   m_stringIndex.clear();
+
+   bool retval = m_file.open(value);
+
+   if (retval && m_readOnly && m_file.size() > 0) {
+      // decode directly from the page cache, falls back to reading the file if mapping fails
+      m_size = m_file.size();
+      m_data = m_file.map(0, m_size);
+      m_pos  = 0;
+   }
+
+   if (retval && m_readOnly) {
+      readStringTable();
+   }
+
+   return retval;
+}
+
+void FileStorage::close()
+{
+   if (m_file.isOpen() && ! m_readOnly) {
+      writeStringTable();
+   }
+
+   if (m_data != nullptr) {
+      m_file.unmap(m_data);
+      m_data = nullptr;
+   }
+
+   m_size = 0;
+   m_pos  = 0;
+
+   m_strings.clear();
+   m_stringIndex.clear();
+
+   m_file.close();
+}
+
+void FileStorage::readStringTable()
+{
+   int64_t fileSize = m_file.size();
+
+   if (fileSize < TRAILER_SIZE) {
+      return;
+   }
+
+   uchar trailer[TRAILER_SIZE];
+
+   if (! seek(fileSize - TRAILER_SIZE) || read((char *)trailer, TRAILER_SIZE) != TRAILER_SIZE) {
+      seek(0);
+      return;
+   }
+
+   int64_t tableOffset = getBigEndian(trailer, 8);
+   uint magic          = getBigEndian(trailer + 8, 4);
+   uint version        = getBigEndian(trailer + 12, 4);
+
+   if (magic == STRING_TABLE_MAGIC && version == STRING_TABLE_VERSION && tableOffset <= fileSize - TRAILER_SIZE &&
+         seek(tableOffset)) {
+
+      uint count = unmarshalUInt(this);
+      m_strings.reserve(count);
+
+      for (uint i = 0; i < count; ++i) {
+         m_strings.append(QString::fromUtf8(unmarshalQByteArray(this)));
+      }
+   }
+
+   seek(0);
+}
+
+void FileStorage::writeStringTable()
+{
+   int64_t tableOffset = m_file.pos();
+
+   marshalUInt(this, m_strings.size());
+
+   for (const auto &item : m_strings) {
+      marshalQByteArray(this, item.toUtf8());
+   }
+
+   uchar trailer[TRAILER_SIZE];
+
+   putBigEndian(trailer,      tableOffset, 8);
+   putBigEndian(trailer + 8,  STRING_TABLE_MAGIC, 4);
+   putBigEndian(trailer + 12, STRING_TABLE_VERSION, 4);
+
+   m_file.write((const char *)trailer, TRAILER_SIZE);
+}
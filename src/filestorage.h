@@ -19,65 +19,119 @@
 #define FILESTORAGE_H
 
 #include <QFile>
+#include <QHash>
+#include <QVector>
 
 #include <assert.h>
+#include <string.h>
 #include <store.h>
 
 /** @brief Store implementation based on a file.
     Writing is linear, after that the file is re-opened for reading.
-    Reading is random (seek+read).
+    Reading is random (seek+read), the file is memory mapped when possible.
+
+    Short strings are written once to a string table which is stored at the end of the file.
  */
 class FileStorage : public StorageIntf
 {
  public:
-   FileStorage() : m_readOnly(false) {}
+   FileStorage() : m_readOnly(false), m_data(nullptr), m_size(0), m_pos(0) {}
 
-   FileStorage(const QString &name) : m_readOnly(false)
+   FileStorage(const QString &name) : m_readOnly(false), m_data(nullptr), m_size(0), m_pos(0)
    {
       m_file.setFileName(name);
    }
 
    int read(char *buf, uint size) override {
+      if (m_data != nullptr) {
+         size = qMin<int64_t>(size, m_size - m_pos);
+
+         memcpy(buf, m_data + m_pos, size);
+         m_pos += size;
+
+         return size;
+      }
+
       return m_file.read(buf, size);
    }
 
+   const char *readDirect(uint size) override {
+      if (m_data == nullptr || m_pos + size > m_size) {
+         return nullptr;
+      }
+
+      const char *retval = (const char *)m_data + m_pos;
+      m_pos += size;
+
+      return retval;
+   }
+
    int write(const char *buf, uint size) override {
       assert(m_readOnly == false);
       return m_file.write(buf, size);
    }
 
+   int internString(const QString &str) override;
+
+   QString sharedString(uint index) override {
+      if (index < (uint)m_strings.size()) {
+         return m_strings[index];
+      }
+
+      return QString();
+   }
+
    void clear() {
       m_readOnly = false;
 
-      m_file.close();
+      close();
       m_file.setFileName("");
    }
 
-   bool open( QIODevice::OpenModeFlag value)  {
-      m_readOnly = (value == QIODevice::ReadOnly);
-
-      return m_file.open(value);
-   }
+   bool open(QIODevice::OpenModeFlag value);
 
    bool seek(int64_t pos) {
+      if (m_data != nullptr) {
+         if (pos < 0 || pos > m_size) {
+            return false;
+         }
+
+         m_pos = pos;
+         return true;
+      }
+
       return m_file.seek(pos);
    }
 
    int64_t pos() const {
+      if (m_data != nullptr) {
+         return m_pos;
+      }
+
       return m_file.pos();
    }
 
-   void close() {
-      m_file.close();
-   }
+   void close();
 
    void setName(QString name ) {
       m_file.setFileName(name);
    }
 
  private:
+   void readStringTable();
+   void writeStringTable();
+
    bool  m_readOnly;
    QFile m_file;
+
+   // file contents when the file was mapped for reading
+   uchar  *m_data;
+   int64_t m_size;
+   int64_t m_pos;
+
+   // strings written once, indexed by internString()
+   QVector<QString>    m_strings;
+   QHash<QString, int> m_stringIndex;
 };
 
 #endif
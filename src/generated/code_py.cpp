@@ -2021,16 +2021,16 @@ static bool findMemberLink(CodeOutputInterface &ol, QSharedPointer<Definition> d
 static void findMemberLink(CodeOutputInterface &ol, const QString &phrase)
 {
    if (g_currentDefinition) {
-      auto iter = Doxy_Globals::glossary().find(phrase);
+      const SymbolList *symbols = Doxy_Globals::glossary().find(phrase);
 
-      while (iter != Doxy_Globals::glossary().end() && iter.key() == phrase) {
-         QSharedPointer<Definition> def = sharedFrom(iter.value());
+      if (symbols != nullptr) {
+         for (const auto &symbol : *symbols) {
+            QSharedPointer<Definition> def = sharedFrom(symbol.def);
 
-         if (findMemberLink(ol, def, phrase)) {
-            return;
+            if (findMemberLink(ol, def, phrase)) {
+               return;
+            }
          }
-
-         ++iter;
       }
    }
 
@@ -3702,6 +3702,8 @@ static void addXRefItem(const QString &listName, const QString &itemTitle, const
       return;
    }
 
+   Doxy_Globals::parseSideEffects++;
+
    auto refList = Doxy_Globals::xrefLists.find(listName);
 
    if (refList == Doxy_Globals::xrefLists.end()) {
@@ -3793,6 +3795,8 @@ static QString addFormula()
    QString formLabel;
    QString fText = formulaText.simplified();
 
+   Doxy_Globals::parseSideEffects++;
+
    auto f = Doxy_Globals::formulaDict.find(fText);
 
    if (f == Doxy_Globals::formulaDict.end()) {
@@ -3832,6 +3836,8 @@ static SectionInfo::SectionType sectionLevelToType(int level)
 
 static void addSection()
 {
+   Doxy_Globals::parseSideEffects++;
+
    QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(s_sectionLabel);
 
    if (si) {
@@ -3865,7 +3871,9 @@ static void addSection()
 static void addCite()
 {
    QString text = QString::fromUtf8(commentscanYYtext);
+
    Doxy_Globals::citeDict.insert(text);
+   Doxy_Globals::parseSideEffects++;
 }
 
 // strip trailing whitespace (excluding newlines) from string s
@@ -3987,6 +3995,8 @@ static inline void setOutput(OutputContext ctx)
 
 static void addAnchor(const QString &anchorName)
 {
+   Doxy_Globals::parseSideEffects++;
+
    QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(anchorName);
 
    if (si) {
@@ -8681,6 +8691,7 @@ void openGroup(QSharedPointer<Entry> e, const QString &, int)
          s_memberGroupId = findExistingGroup(curGroupId, info);
 
          Doxy_Globals::memGrpInfoDict.insert(s_memberGroupId, info);
+         Doxy_Globals::parseSideEffects++;
 
          s_memberGroupRelates = e->relates;
          e->mGrpId = s_memberGroupId;
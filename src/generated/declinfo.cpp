@@ -653,11 +653,16 @@ char *declinfoYYtext;
 
 *************************************************************************/
 
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
 #include <stdio.h>
 #include <assert.h>
 #include <ctype.h>
 
 #include <declinfo.h>
+#include <doxy_globals.h>
 #include <message.h>
 #include <util.h>
 
@@ -2207,7 +2212,7 @@ void declinfoYYfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-void parseFuncDecl(const QString &decl, bool objC, QString &cl, QString &t,
+static void parseDecl(const QString &decl, bool objC, QString &cl, QString &t,
                    QString &n, QString &a, QString &ftl, QString &exc)
 {
    printlex(declinfoYY_flex_debug, TRUE, __FILE__, NULL);
@@ -2273,3 +2278,67 @@ void parseFuncDecl(const QString &decl, bool objC, QString &cl, QString &t,
    return;  
 }
 
+// several entries are often matched using the same declaration
+struct ParsedDecl {
+   QString className;
+   QString type;
+   QString name;
+   QString args;
+   QString funcTempList;
+   QString exceptions;
+};
+
+static const int MAX_CACHED_DECLS = 16384;
+
+static QMutex                                    s_declMutex;
+static QHash<QPair<QString, bool>, ParsedDecl>   s_declCache;
+
+static long s_declHits   = 0;
+static long s_declMisses = 0;
+
+void parseFuncDecl(const QString &decl, bool objC, QString &cl, QString &t,
+                   QString &n, QString &a, QString &ftl, QString &exc)
+{
+   // scanner state is global, only one thread can parse at a time
+   QMutexLocker lock(&s_declMutex);
+
+   QPair<QString, bool> key(decl, objC);
+   auto iter = s_declCache.constFind(key);
+
+   if (iter != s_declCache.constEnd()) {
+      ++s_declHits;
+
+      cl  = iter->className;
+      t   = iter->type;
+      n   = iter->name;
+      a   = iter->args;
+      ftl = iter->funcTempList;
+      exc = iter->exceptions;
+
+      return;
+   }
+
+   ++s_declMisses;
+
+   // the scanner does not assign every result, start from empty values so the cached results are complete
+   cl  = QString();
+   t   = QString();
+   n   = QString();
+   a   = QString();
+   ftl = QString();
+   exc = QString();
+
+   parseDecl(decl, objC, cl, t, n, a, ftl, exc);
+
+   if (s_declCache.size() < MAX_CACHED_DECLS) {
+      s_declCache.insert(key, ParsedDecl{cl, t, n, a, ftl, exc});
+   }
+}
+
+void addFuncDeclStatistics()
+{
+   QMutexLocker lock(&s_declMutex);
+
+   Doxy_Globals::infoLog_Stat.addCounter("declarations parsed",        s_declMisses);
+   Doxy_Globals::infoLog_Stat.addCounter("declarations parsed cached", s_declHits);
+}
@@ -863,6 +863,9 @@ char *default_argsYYtext;
 
 *************************************************************************/
 
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegExp>
 
 #include <stdio.h>
@@ -871,6 +874,7 @@ char *default_argsYYtext;
 
 #include <arguments.h>
 #include <default_args.h>
+#include <doxy_globals.h>
 #include <entry.h>
 #include <message.h>
 #include <util.h>
@@ -2973,12 +2977,8 @@ ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList
    return stringToArgumentList(argsString, al, dummy);
 }
 
-ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList &al, QString &extraTypeChars)
+static ArgumentList parseArgumentList(const QString &argsString, const ArgumentList &al, QString &extraTypeChars)
 {
-   if (argsString.isEmpty()) {
-      return ArgumentList();
-   }
-
    printlex(default_argsYY_flex_debug, true, __FILE__, NULL);
 
    g_copyArgValue = 0;
@@ -3012,3 +3012,71 @@ ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList
    return g_argList;
 }
 
+// the same argument strings like "()", "(void)" or "(int)" are parsed over and over
+struct ParsedArguments {
+   ArgumentList argList;
+   QString extraTypeChars;
+};
+
+// longer argument strings usually contain documentation and are not added to the cache
+static const int MAX_CACHED_LENGTH = 256;
+static const int MAX_CACHED_LISTS  = 32768;
+
+static QMutex                           s_argListMutex;
+static QHash<QString, ParsedArguments>  s_argListCache;
+
+static long s_argListHits   = 0;
+static long s_argListMisses = 0;
+
+// matchArguments2() stores canonical types in the arguments which depend on the scope of the caller,
+// modifying the copy detaches it from the list in the cache
+static ArgumentList detachedCopy(const ArgumentList &al)
+{
+   ArgumentList retval = al;
+   retval.clearCanonicalTypes();
+
+   return retval;
+}
+
+ArgumentList stringToArgumentList(const QString &argsString, const ArgumentList &al, QString &extraTypeChars)
+{
+   if (argsString.isEmpty()) {
+      return ArgumentList();
+   }
+
+   // scanner state is global, only one thread can parse at a time
+   QMutexLocker lock(&s_argListMutex);
+
+   if (! al.listEmpty() || argsString.length() > MAX_CACHED_LENGTH) {
+      // arguments are merged into an existing list
+      return parseArgumentList(argsString, al, extraTypeChars);
+   }
+
+   auto iter = s_argListCache.constFind(argsString);
+
+   if (iter != s_argListCache.constEnd()) {
+      ++s_argListHits;
+
+      extraTypeChars = iter->extraTypeChars;
+      return detachedCopy(iter->argList);
+   }
+
+   ++s_argListMisses;
+
+   ArgumentList retval = parseArgumentList(argsString, al, extraTypeChars);
+
+   if (s_argListCache.size() < MAX_CACHED_LISTS) {
+      s_argListCache.insert(argsString, ParsedArguments{retval, extraTypeChars});
+      return detachedCopy(retval);
+   }
+
+   return retval;
+}
+
+void addArgumentListStatistics()
+{
+   QMutexLocker lock(&s_argListMutex);
+
+   Doxy_Globals::infoLog_Stat.addCounter("argument lists parsed",        s_argListMisses);
+   Doxy_Globals::infoLog_Stat.addCounter("argument lists parsed cached", s_argListHits);
+}
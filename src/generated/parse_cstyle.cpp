@@ -12345,7 +12345,6 @@ static int yyBegLineNr  = yyLineNr;
 static int yyColNr      = 1;
 static int yyBegColNr   = yyColNr;
 static int anonCount    = 0;
-static int anonNSCount  = 0;
 
 static QString          yyFileName;
 static MethodTypes      mtype;
@@ -15145,6 +15144,7 @@ YY_RULE_SETUP
       // while they should be aware of the scope they are in
       QString text = QString::fromUtf8(parse_cstyle_YYtext);
       Doxy_Globals::namespaceAliasDict.insert(aliasName, text);
+      Doxy_Globals::parseSideEffects++;
    }
 	YY_BREAK
 case 136:
@@ -15201,6 +15201,8 @@ YY_RULE_SETUP
       Doxy_Globals::namespaceAliasDict.insert(text,
             removeRedundantWhiteSpace(substitute(aliasName,"\\","::")));
 
+      Doxy_Globals::parseSideEffects++;
+
       aliasName.resize(0);
    }
 	YY_BREAK
@@ -18828,6 +18830,7 @@ YY_RULE_SETUP
 {
       /* typedef of anonymous type */
       current->name = QString("@%1").arg(anonCount++);
+      Doxy_Globals::parseSideEffects++;
 
       bool isEnum = current->m_traits.hasTrait(Entry::Virtue::Enum);
 
@@ -18930,6 +18933,7 @@ YY_RULE_SETUP
                   // anonymous compound inside -> insert dummy variable name
 
                   msName = QString("@%1").arg(anonCount++);
+                  Doxy_Globals::parseSideEffects++;
                   break;
                }
             }
@@ -21720,11 +21724,13 @@ YY_RULE_SETUP
 
             } else {
                // use invisible name
-               current->name = QString("@%1").arg(anonNSCount);
+               current->name = QString("@%1").arg(Doxy_Globals::anonNSCount);
+               Doxy_Globals::parseSideEffects++;
             }
 
          } else {
             current->name = QString("@%1").arg(anonCount++);
+            Doxy_Globals::parseSideEffects++;
          }
       }
 
@@ -24715,7 +24721,7 @@ static void parseMain(const QString &fileName, const QString &fileBuf, QStringLi
       parseCompounds(rt);
       s_inputFile.close();
 
-      anonNSCount++;
+      Doxy_Globals::anonNSCount++;
    }
 }
 
@@ -2709,16 +2709,28 @@ class DefineManager
 
       /** Adds an include file for this file
        *  @param fileName The name of the include file
+       *  @return true if the include file was not yet known
        */
-      void addInclude(const QString &fileName) {
+      bool addInclude(const QString &fileName) {
+         if (m_includedFiles.contains(fileName)) {
+            return false;
+         }
+
          m_includedFiles.insert(fileName);
+         return true;
       }
 
       void collectDefines(DefineDict &dict, QSet<QString> &includeStack);
 
     private:
+      friend class DefineManager;
+
       DefineDict m_defines;
       QSet<QString> m_includedFiles;
+
+      // defines of this file and all included files, valid until one of these files changes
+      DefineDict m_collected;
+      bool m_collectedValid = false;
    };
 
  public:
@@ -2781,10 +2793,13 @@ class DefineManager
          m_fileMap.insert(fileName, dpf);
 
       } else {
-         // existing file
+         // existing file, add the defines of the file and everything it includes
 
-         QSet<QString> includeStack;
-         dpf->collectDefines(m_contextDefines, includeStack);
+         const DefineDict &collected = collectedDefines(dpf);
+
+         for (auto iter = collected.begin(); iter != collected.end(); ++iter) {
+            m_contextDefines.insert(iter.key(), iter.value());
+         }
       }
    }
 
@@ -2815,6 +2830,7 @@ class DefineManager
       }
 
       dpf->addDefine(def);
+      invalidate(fileName);
    }
 
    /** Add an include relation to the manager object.
@@ -2832,7 +2848,11 @@ class DefineManager
          dpf = QMakeShared<DefinesPerFile>();
          m_fileMap.insert(fromFileName, dpf);
       }
-      dpf->addInclude(toFileName);
+
+      if (dpf->addInclude(toFileName)) {
+         m_includedBy[toFileName].insert(fromFileName);
+         invalidate(fromFileName);
+      }
    }
 
    /** Returns a Define object given its name or 0 if the Define does not exist.
@@ -2852,6 +2872,16 @@ class DefineManager
       return m_contextDefines;
    }
 
+   /** Returns how often the collected defines of an include file were reused */
+   int collectHits() const {
+      return m_collectHits;
+   }
+
+   /** Returns how often the collected defines of an include file were computed */
+   int collectMisses() const {
+      return m_collectMisses;
+   }
+
  private:
    static DefineManager *theInstance;
 
@@ -2864,8 +2894,66 @@ class DefineManager
       QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fileName);
 
       if (dpf) {
+         const DefineDict &collected = collectedDefines(dpf);
+
+         for (auto iter = collected.begin(); iter != collected.end(); ++iter) {
+            dict->insert(iter.key(), iter.value());
+         }
+      }
+   }
+
+   /** Returns the defines of a file and all files it includes, computed once
+    *  and reused until the defines or includes of one of these files change.
+    */
+   const DefineDict &collectedDefines(QSharedPointer<DefinesPerFile> dpf) {
+      if (dpf->m_collectedValid) {
+         ++m_collectHits;
+
+      } else {
+         ++m_collectMisses;
+
          QSet<QString> includeStack;
-         dpf->collectDefines(*dict, includeStack);
+         dpf->m_collected.clear();
+         dpf->collectDefines(dpf->m_collected, includeStack);
+
+         dpf->m_collectedValid = true;
+         ++m_validCount;
+      }
+
+      return dpf->m_collected;
+   }
+
+   /** Drops the collected defines of a file and of every file which includes it */
+   void invalidate(const QString &fileName) {
+      if (m_validCount == 0) {
+         return;
+      }
+
+      QSet<QString> visited;
+      QStack<QString> pending;
+
+      pending.push(fileName);
+
+      while (! pending.isEmpty()) {
+         QString name = pending.pop();
+
+         if (visited.contains(name)) {
+            continue;
+         }
+
+         visited.insert(name);
+
+         QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(name);
+
+         if (dpf && dpf->m_collectedValid) {
+            dpf->m_collectedValid = false;
+            dpf->m_collected.clear();
+            --m_validCount;
+         }
+
+         for (const auto &includer : m_includedBy.value(name)) {
+            pending.push(includer);
+         }
       }
    }
 
@@ -2885,7 +2973,12 @@ class DefineManager
    }
 
    QHash<QString, QSharedPointer<DefinesPerFile>> m_fileMap;
+   QHash<QString, QSet<QString>> m_includedBy;
    DefineDict m_contextDefines;
+
+   int m_validCount    = 0;
+   int m_collectHits   = 0;
+   int m_collectMisses = 0;
 };
 
 /** Singleton instance */
@@ -3038,6 +3131,7 @@ static void setCaseDone(bool value)
 }
 
 static QSet<QString> g_allIncludes;
+static int           g_includeSkips = 0;
 
 static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool &alreadyIncluded)
 {
@@ -3046,6 +3140,14 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
 
    QFileInfo fi(fileName);
 
+   if (g_curlyCount == 0 && g_allIncludes.contains(fi.absoluteFilePath())) {
+      // header was already read, no need to access the file system
+      alreadyIncluded = true;
+      ++g_includeSkips;
+
+      return QSharedPointer<FileState>();
+   }
+
    if (fi.exists() && fi.isFile()) {
       static const QStringList exclPatterns = Config::getList("exclude-patterns");
 
@@ -3106,17 +3208,122 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
    return fs;
 }
 
+// directory contents of the include directories, used to skip directories which do not contain an include file
+static QHash<QString, QSet<QString>> g_dirListings;
+
+// result of findFile for an include, an empty value indicates the include file was not found
+static QHash<QString, QString> g_resolvedIncludes;
+
+static int g_resolveHits   = 0;
+static int g_resolveMisses = 0;
+
+static QString dirListingKey(const QString &name)
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MACX)
+   // case insensitive file system
+   return name.toLower();
+#else
+   return name;
+#endif
+}
+
+static const QSet<QString> &dirListing(const QString &dirName)
+{
+   auto iter = g_dirListings.find(dirName);
+
+   if (iter == g_dirListings.end()) {
+      QSet<QString> entries;
+      QDir dir(dirName);
+
+      const QStringList list = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+
+      for (const auto &item : list) {
+         entries.insert(dirListingKey(item));
+      }
+
+      iter = g_dirListings.insert(dirName, entries);
+   }
+
+   return iter.value();
+}
+
+// returns false if relName definitely does not exist in dirName, true if it may exist
+static bool existsInDir(const QString &dirName, const QString &relName)
+{
+   if (relName.contains('\\')) {
+      // unusual path, let the file system decide
+      return true;
+   }
+
+   const QStringList parts = relName.split('/');
+   QString path = dirName;
+
+   for (const auto &part : parts) {
+
+      if (part.isEmpty() || part == "." || part == "..") {
+         return true;
+      }
+
+      if (! dirListing(path).contains(dirListingKey(part))) {
+         return false;
+      }
+
+      path += "/" + part;
+   }
+
+   return true;
+}
+
 static QSharedPointer<FileState> findFile(const QString &fileName, bool localInclude, bool &alreadyIncluded)
 {
+   QString key = "\n" + fileName;
+
+   if (localInclude && ! g_yyFileName.isEmpty()) {
+      // local includes also depend on the directory of the including file
+      key.prepend(QFileInfo(g_yyFileName).absolutePath());
+   }
+
+   auto iter = g_resolvedIncludes.find(key);
+
+   if (iter != g_resolvedIncludes.end()) {
+      ++g_resolveHits;
+
+      if (iter.value().isEmpty()) {
+         alreadyIncluded = false;
+         return QSharedPointer<FileState>();
+      }
+
+      QString absName = iter.value();
+      QSharedPointer<FileState> fs = checkAndOpenFile(absName, alreadyIncluded);
+
+      if (fs) {
+         setFileName(absName);
+         g_yyLineNr = 1;
+         return fs;
+
+      } else if (alreadyIncluded) {
+         return QSharedPointer<FileState>();
+      }
+
+      // file could not be read, search again
+
+   } else {
+      ++g_resolveMisses;
+
+   }
+
    if (QDir::isAbsolutePath(fileName)) {
       QSharedPointer<FileState> fs = checkAndOpenFile(fileName, alreadyIncluded);
 
       if (fs) {
+         g_resolvedIncludes.insert(key, fileName);
+
          setFileName(fileName);
          g_yyLineNr = 1;
          return fs;
 
       } else if (alreadyIncluded) {
+         g_resolvedIncludes.insert(key, fileName);
          return QSharedPointer<FileState>();
       }
    }
@@ -3124,40 +3331,48 @@ static QSharedPointer<FileState> findFile(const QString &fileName, bool localInc
    if (localInclude && ! g_yyFileName.isEmpty()) {
       QFileInfo fi(g_yyFileName);
 
-      if (fi.exists()) {
+      if (fi.exists() && existsInDir(fi.absolutePath(), fileName)) {
          QString absName = fi.absolutePath() + "/" + fileName;
          QSharedPointer<FileState> fs = checkAndOpenFile(absName, alreadyIncluded);
 
          if (fs) {
+            g_resolvedIncludes.insert(key, absName);
+
             setFileName(absName);
             g_yyLineNr = 1;
             return fs;
 
          } else if (alreadyIncluded) {
+            g_resolvedIncludes.insert(key, absName);
             return QSharedPointer<FileState>();
          }
       }
    }
 
-   if (g_pathList.isEmpty()) {
-      return QSharedPointer<FileState>();
-   }
-
    for (auto &s : g_pathList) {
-      QString absName = s + "/" + fileName;
 
+      if (! existsInDir(s, fileName)) {
+         continue;
+      }
+
+      QString absName = s + "/" + fileName;
       QSharedPointer<FileState> fs = checkAndOpenFile(absName, alreadyIncluded);
 
       if (fs) {
+         g_resolvedIncludes.insert(key, absName);
+
          setFileName(absName);
          g_yyLineNr = 1;
          return fs;
 
       } else if (alreadyIncluded) {
+         g_resolvedIncludes.insert(key, absName);
          return QSharedPointer<FileState>();
       }
    }
 
+   g_resolvedIncludes.insert(key, QString());
+
    return QSharedPointer<FileState>();
 }
 
@@ -4092,10 +4307,7 @@ void addDefine()
                MemberType_Define, ArgumentList(), ArgumentList());
 
    if (! g_defArgsStr.isEmpty()) {
-      ArgumentList argList;
-
-      argList = stringToArgumentList(g_defArgsStr);
-      md->setArgumentList(argList);
+      md->setArgumentList(stringToArgumentList(g_defArgsStr));
    }
 
    int l = g_defLitText.indexOf('\n');
@@ -4150,6 +4362,23 @@ static inline void outputArray(const QString &a, int len)
    }
 }
 
+// absolute paths of the existing directories in the include path
+static QStringList includePathDirs()
+{
+   QStringList retval;
+   const QStringList includePath = Config::getList("include-path");
+
+   for (const auto &s : includePath) {
+      QFileInfo fi(s);
+
+      if (fi.exists() && fi.isDir()) {
+         retval.append(fi.absoluteFilePath());
+      }
+   }
+
+   return retval;
+}
+
 static void readIncludeFile(const QString &inc)
 {
    static bool searchIncludes = Config::getBool("search-includes");
@@ -4199,23 +4428,18 @@ static void readIncludeFile(const QString &inc)
                absIncFileName = fi2.absoluteFilePath();
 
             } else if (searchIncludes) {
-               const QStringList includePath = Config::getList("include-path");
-
-               for (auto s : includePath) {
+               static const QStringList includeDirs = includePathDirs();
 
-                  QFileInfo fi(s);
+               for (const auto &dirName : includeDirs) {
 
-                  if (fi.exists() && fi.isDir()) {
-                     QString absName = fi.absoluteFilePath() + "/" + incFileName;
+                  if (existsInDir(dirName, incFileName)) {
+                     QFileInfo fi2(dirName + "/" + incFileName);
 
-                     QFileInfo fi2(absName);
                      if (fi2.exists()) {
                         absIncFileName = fi2.absoluteFilePath();
                         break;
                      }
-
                   }
-
                }
             }
 
@@ -7931,6 +8155,8 @@ void removePreProcessor()
 {
    g_expandedDict = QSharedPointer<DefineDict>();
    g_pathList.clear();
+   g_dirListings.clear();
+   g_resolvedIncludes.clear();
 
    DefineManager::deleteInstance();
 }
@@ -8133,3 +8359,11 @@ void preFreeScanner()
    }
 }
 
+void preAddStatistics()
+{
+   Doxy_Globals::infoLog_Stat.addCounter("include files skipped, already read", g_includeSkips);
+   Doxy_Globals::infoLog_Stat.addCounter("include file lookups cached",   g_resolveHits);
+   Doxy_Globals::infoLog_Stat.addCounter("include file lookups searched", g_resolveMisses);
+   Doxy_Globals::infoLog_Stat.addCounter("include file defines reused",   DefineManager::instance().collectHits());
+   Doxy_Globals::infoLog_Stat.addCounter("include file defines computed", DefineManager::instance().collectMisses());
+}
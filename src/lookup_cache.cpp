@@ -0,0 +1,130 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <lookup_cache.h>
+
+#include <classdef.h>
+#include <definition.h>
+#include <filedef.h>
+#include <memberdef.h>
+
+LookupCache::LookupCache()
+   : m_maxSize(65536)
+{
+}
+
+void LookupCache::setMaxSize(int size)
+{
+   QWriteLocker lock(&m_lock);
+   m_maxSize = size;
+}
+
+int LookupCache::count() const
+{
+   QReadLocker lock(&m_lock);
+   return m_cache.size();
+}
+
+bool LookupCache::find(const LookupKey &key, LookupInfo &info) const
+{
+   QReadLocker lock(&m_lock);
+
+   auto iter = m_cache.constFind(key);
+
+   if (iter == m_cache.constEnd()) {
+      return false;
+   }
+
+   // scope was deleted and the address was reused by another definition
+   if (iter->scope.isNull() || (key.fileScope != nullptr && iter->fileScope.isNull())) {
+      return false;
+   }
+
+   info = iter->info;
+
+   return true;
+}
+
+void LookupCache::insert(const LookupKey &key, QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope,
+                  const LookupInfo &info)
+{
+   QWriteLocker lock(&m_lock);
+
+   auto iter = m_cache.find(key);
+
+   if (iter != m_cache.end()) {
+      iter->scope     = scope;
+      iter->fileScope = fileScope;
+      iter->info      = info;
+
+      return;
+   }
+
+   while (! m_order.empty() && m_cache.size() >= m_maxSize) {
+      m_cache.remove(m_order.front());
+      m_order.pop_front();
+   }
+
+   m_cache.insert(key, CacheEntry{scope, fileScope, info});
+   m_order.push_back(key);
+}
+
+void LookupCache::clear()
+{
+   QWriteLocker lock(&m_lock);
+
+   m_cache.clear();
+   m_order.clear();
+}
+
+template <typename Func>
+void LookupCache::removeIf(Func shouldRemove)
+{
+   QWriteLocker lock(&m_lock);
+
+   std::deque<LookupKey> order;
+
+   for (const auto &key : m_order) {
+      auto iter = m_cache.find(key);
+
+      if (shouldRemove(iter.value())) {
+         m_cache.erase(iter);
+
+      } else {
+         order.push_back(key);
+      }
+   }
+
+   m_order = std::move(order);
+}
+
+void LookupCache::removeResolved()
+{
+   removeIf([](const CacheEntry &entry) {
+      return entry.info.classDef != nullptr;
+   });
+}
+
+void LookupCache::removeUnresolved()
+{
+   removeIf([](const CacheEntry &entry) {
+      return entry.info.classDef == nullptr;
+   });
+}
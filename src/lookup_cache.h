@@ -0,0 +1,127 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef LOOKUP_CACHE_H
+#define LOOKUP_CACHE_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QString>
+#include <QWeakPointer>
+
+#include <deque>
+
+class ClassDef;
+class Definition;
+class FileDef;
+class MemberDef;
+
+struct LookupInfo {
+   LookupInfo() {}
+
+   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
+      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
+   {}
+
+   QSharedPointer<ClassDef>  classDef;
+   QSharedPointer<MemberDef> typeDef;
+
+   QString templSpec;
+   QString resolvedType;
+};
+
+// identifies one lookup of a class or typedef name done by getResolvedClass()
+struct LookupKey {
+   const Definition *scope;
+   const FileDef    *fileScope;     // only set if the file contains using statements
+
+   QString name;
+   QString explicitScopePart;
+
+   bool operator==(const LookupKey &other) const {
+      return scope == other.scope && fileScope == other.fileScope &&
+             name == other.name && explicitScopePart == other.explicitScopePart;
+   }
+};
+
+inline uint qHash(const LookupKey &key)
+{
+   uint retval = qHash(key.name);
+
+   retval = retval * 31 + qHash(key.explicitScopePart);
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.scope));
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.fileScope));
+
+   return retval;
+}
+
+/** \brief Cache of the results of getResolvedClass()
+ *
+ *  The same name is often searched in the same scope, so the results are cached. Entries are
+ *  keyed by the scope, the file scope and the name. Since the scope and the file scope are only
+ *  compared by address, every entry holds a weak reference to both and an entry is ignored once
+ *  one of them was deleted.
+ *
+ *  Lookups take a read lock so the cache can be shared by threads which resolve names. When the
+ *  relations between definitions change only the entries which may have a different result are
+ *  removed.
+ */
+class LookupCache
+{
+ public:
+   LookupCache();
+
+   void setMaxSize(int size);
+
+   int maxSize() const {
+      return m_maxSize;
+   }
+
+   int count() const;
+
+   bool find(const LookupKey &key, LookupInfo &info) const;
+   void insert(const LookupKey &key, QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope,
+                  const LookupInfo &info);
+
+   void clear();
+
+   // removes entries which resolved to a class or typedef
+   void removeResolved();
+
+   // removes entries which did not resolve to a class, including typedef only entries
+   void removeUnresolved();
+
+ private:
+   struct CacheEntry {
+      QWeakPointer<Definition> scope;
+      QWeakPointer<FileDef>    fileScope;
+      LookupInfo info;
+   };
+
+   template <typename Func>
+   void removeIf(Func shouldRemove);
+
+   mutable QReadWriteLock m_lock;
+
+   QHash<LookupKey, CacheEntry> m_cache;
+   std::deque<LookupKey> m_order;         // insertion order, used to remove the oldest entries
+
+   int m_maxSize;
+};
+
+#endif
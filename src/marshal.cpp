@@ -27,29 +27,69 @@
 
 #define HEADER ('D'<<24)+('O'<<16)+('X'<<8)+'!'
 
+// integers are written as LEB128 varints, signed values are zigzag encoded first
+static void marshalVarint(StorageIntf *s, uint64_t v)
+{
+   uchar b[10];
+   int len = 0;
+
+   do {
+      b[len] = v & 0x7f;
+      v >>= 7;
+
+      if (v != 0) {
+         b[len] |= 0x80;
+      }
+
+      ++len;
+
+   } while (v != 0);
+
+   s->write((const char *)b, len);
+}
+
+static uint64_t unmarshalVarint(StorageIntf *s)
+{
+   uint64_t result = 0;
+   int shift       = 0;
+
+   while (shift < 64) {
+      uchar c;
+      const char *data = s->readDirect(1);
+
+      if (data != nullptr) {
+         c = *data;
+
+      } else if (s->read((char *)&c, 1) != 1) {
+         break;
+      }
+
+      result |= uint64_t(c & 0x7f) << shift;
+      shift  += 7;
+
+      if ((c & 0x80) == 0) {
+         break;
+      }
+   }
+
+   return result;
+}
+
 void marshalInt(StorageIntf *s, int v)
 {
-   uchar b[4];
-   b[0] = ((uint)v) >> 24;
-   b[1] = (((uint)v) >> 16) & 0xff;
-   b[2] = (((uint)v) >> 8) & 0xff;
-   b[3] = v & 0xff;
-   s->write((const char *)b, 4);
+   marshalVarint(s, (uint(v) << 1) ^ uint(v >> 31));
 }
 
 void marshalUInt(StorageIntf *s, uint v)
 {
-   uchar b[4];
-   b[0] = v >> 24;
-   b[1] = (v >> 16) & 0xff;
-   b[2] = (v >> 8) & 0xff;
-   b[3] = v & 0xff;
-   s->write((const char *)b, 4);
+   marshalVarint(s, v);
 }
 
 void marshalTraits(StorageIntf *s, Entry::Traits v)
 {
-   marshalQByteArray(s, v.toQByteArray());
+   for (int i = 0; i < Entry::Traits::numWords; ++i) {
+      marshalVarint(s, v.toWord(i));
+   }
 }
 
 void marshalBool(StorageIntf *s, bool b)
@@ -58,6 +98,23 @@ void marshalBool(StorageIntf *s, bool b)
    s->write(&c, sizeof(char));
 }
 
+// several bools packed into one varint, the first value is the lowest bit
+void marshalFlags(StorageIntf *s, std::initializer_list<bool> flags)
+{
+   uint value = 0;
+   int bit    = 0;
+
+   for (bool item : flags) {
+      if (item) {
+         value |= (1u << bit);
+      }
+
+      ++bit;
+   }
+
+   marshalVarint(s, value);
+}
+
 void marshalQByteArray(StorageIntf *s, const QByteArray &str)
 {
    uint len = str.length();
@@ -68,12 +125,21 @@ void marshalQByteArray(StorageIntf *s, const QByteArray &str)
    }
 }
 
+// a string is written as a reference to the string table of the store (even tag) or
+// in full (odd tag), the remaining bits of the tag are the index or the length
 void marshalQString(StorageIntf *s, const QString &str)
 {
+   int index = s->internString(str);
+
+   if (index >= 0) {
+      marshalVarint(s, uint64_t(index) << 1);
+      return;
+   }
+
    QByteArray temp = str.toUtf8();
 
    uint len = temp.length();
-   marshalUInt(s, len);
+   marshalVarint(s, (uint64_t(len) << 1) | 1);
 
    if (len > 0) {
       s->write(temp.constData(), len);
@@ -87,15 +153,10 @@ void marshalArgumentList(StorageIntf *s, const ArgumentList &argList)
 
 void marshalArgumentLists(StorageIntf *s, const QVector<ArgumentList> &argLists)
 {
-   if (argLists.isEmpty()) {
-      marshalUInt(s, NULL_LIST);
+   marshalUInt(s, argLists.count());
 
-   } else {
-      marshalUInt(s, argLists.count());
-
-      for (auto &al : argLists) {
-         marshalArgumentList(s, al);
-      }
+   for (auto &al : argLists) {
+      marshalArgumentList(s, al);
    }
 }
 
@@ -117,51 +178,36 @@ void marshalBaseInfoList(StorageIntf *s, QVector<BaseInfo> *baseList)
 
 void marshalGroupingList(StorageIntf *s, const QVector<Grouping> &groups)
 {
-   if (groups.isEmpty()) {
-      marshalUInt(s, NULL_LIST);
-
-   } else {
-      marshalUInt(s, groups.count());
+   marshalUInt(s, groups.count());
 
-      for (auto &g : groups) {
-         marshalQString(s, g.groupname);
-         marshalInt(s, g.pri);
-      }
+   for (auto &g : groups) {
+      marshalQString(s, g.groupname);
+      marshalInt(s, g.pri);
    }
 }
 
 void marshalSectionInfoList(StorageIntf *s, const QVector<SectionInfo> &anchors)
 {
-   if (anchors.isEmpty()) {
-      marshalUInt(s, NULL_LIST);
+   marshalUInt(s, anchors.count());
 
-   } else {
-      marshalUInt(s, anchors.count());
-
-      for (auto &si : anchors) {
-         marshalQString(s, si.label);
-         marshalQString(s, si.title);
-         marshalQString(s, si.ref);
-         marshalInt(s,     si.type);
-         marshalQString(s, si.fileName);
-         marshalInt(s,     si.lineNr);
-         marshalInt(s,     si.level);
-      }
+   for (auto &si : anchors) {
+      marshalQString(s, si.label);
+      marshalQString(s, si.title);
+      marshalQString(s, si.ref);
+      marshalInt(s,     si.type);
+      marshalQString(s, si.fileName);
+      marshalInt(s,     si.lineNr);
+      marshalInt(s,     si.level);
    }
 }
 
 void marshalItemInfoList(StorageIntf *s, const QVector<ListItemInfo> &list)
 {
-   if (list.isEmpty()) {
-      marshalUInt(s, NULL_LIST);
+   marshalUInt(s, list.count());
 
-   } else {
-      marshalUInt(s, list.count());
-
-      for (auto &item : list) {
-         marshalQString(s, item.type);
-         marshalInt(s, item.itemId);
-      }
+   for (auto &item : list) {
+      marshalQString(s, item.type);
+      marshalInt(s, item.itemId);
    }
 }
 
@@ -196,12 +242,8 @@ void marshalEntry(StorageIntf *s, QSharedPointer<Entry> e)
    marshalInt(s,     e->mtype);
    marshalTraits(s,  e->m_traits);
    marshalInt(s,     e->initLines);
-   marshalBool(s,    e->stat);
-   marshalBool(s,    e->explicitExternal);
-   marshalBool(s,    e->proto);
-   marshalBool(s,    e->subGrouping);
-   marshalBool(s,    e->callGraph);
-   marshalBool(s,    e->callerGraph);
+   marshalFlags(s,   { e->stat, e->explicitExternal, e->proto, e->subGrouping, e->callGraph, e->callerGraph,
+                       e->hidden, e->artificial });
    marshalInt(s,     e->virt);
    marshalQString(s, e->args);
    marshalQString(s, e->bitfields);
@@ -252,8 +294,6 @@ void marshalEntry(StorageIntf *s, QSharedPointer<Entry> e)
    marshalInt(s,             e->startLine);
    marshalItemInfoList(s,    e->m_specialLists);
    marshalInt(s,             e->lang);
-   marshalBool(s,            e->hidden);
-   marshalBool(s,            e->artificial);
    marshalInt(s,             e->groupDocType);
    marshalQString(s,         e->id);
 }
@@ -270,32 +310,45 @@ void marshalEntryTree(StorageIntf *s, QSharedPointer<Entry> e)
 
 int unmarshalInt(StorageIntf *s)
 {
-   uchar b[4];
-   s->read((char *)b, 4);
-   int result = (int)((((uint)b[0]) << 24) + ((uint)b[1] << 16) + ((uint)b[2] << 8) + (uint)b[3]);
+   uint v = unmarshalVarint(s);
+   int result = (int)((v >> 1) ^ (~(v & 1) + 1));
 
    return result;
 }
 
 uint unmarshalUInt(StorageIntf *s)
 {
-   uchar b[4];
-   s->read((char *)b, 4);
-   uint result = (((uint)b[0]) << 24) + ((uint)b[1] << 16) + ((uint)b[2] << 8) + (uint)b[3];
+   uint result = unmarshalVarint(s);
 
    return result;
 }
 
 Entry::Traits unmarshalTraits(StorageIntf *s)
 {
-   QByteArray temp = unmarshalQByteArray(s);
-   Entry::Traits result = Entry::Traits::fromQByteArray(temp);
+   Entry::Traits result;
+
+   for (int i = 0; i < Entry::Traits::numWords; ++i) {
+      result.setWord(i, unmarshalVarint(s));
+   }
+
+   return result;
+}
+
+uint unmarshalFlags(StorageIntf *s)
+{
+   uint result = unmarshalVarint(s);
 
    return result;
 }
 
 bool unmarshalBool(StorageIntf *s)
 {
+   const char *data = s->readDirect(sizeof(char));
+
+   if (data != nullptr) {
+      return *data;
+   }
+
    char result;
    s->read(&result, sizeof(result));
 
@@ -306,6 +359,14 @@ QByteArray unmarshalQByteArray(StorageIntf *s)
 {
    uint len = unmarshalUInt(s);
 
+   if (len > 0) {
+      const char *data = s->readDirect(len);
+
+      if (data != nullptr) {
+         return QByteArray(data, len);
+      }
+   }
+
    QByteArray result;
    result.resize(len);
 
@@ -318,7 +379,22 @@ QByteArray unmarshalQByteArray(StorageIntf *s)
 
 QString unmarshalQString(StorageIntf *s)
 {
-   uint len = unmarshalUInt(s);
+   uint64_t tag = unmarshalVarint(s);
+
+   if ((tag & 1) == 0) {
+      return s->sharedString(tag >> 1);
+   }
+
+   uint len = tag >> 1;
+
+   if (len > 0) {
+      const char *data = s->readDirect(len);
+
+      if (data != nullptr) {
+         // decode the mapped UTF-8 data without an intermediate copy
+         return QString::fromUtf8(data, len);
+      }
+   }
 
    QByteArray result;
    result.resize(len);
@@ -475,10 +551,14 @@ BriefInfo *unmarshalBriefInfo(StorageIntf *s)
 
 QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
 {
-   QSharedPointer<Entry> e = QMakeShared<Entry>();
-
    uint header = unmarshalUInt(s);
-   assert(header == HEADER);
+
+   if (header != HEADER) {
+      // storage is corrupt or does not contain an entry at this position
+      return QSharedPointer<Entry>();
+   }
+
+   QSharedPointer<Entry> e = QMakeShared<Entry>();
 
    e->name             = unmarshalQString(s);
    e->type             = unmarshalQString(s);
@@ -487,12 +567,17 @@ QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
    e->mtype            = static_cast<MethodTypes>(unmarshalInt(s));
    e->m_traits         = unmarshalTraits(s);
    e->initLines        = unmarshalInt(s);
-   e->stat             = unmarshalBool(s);
-   e->explicitExternal = unmarshalBool(s);
-   e->proto            = unmarshalBool(s);
-   e->subGrouping      = unmarshalBool(s);
-   e->callGraph        = unmarshalBool(s);
-   e->callerGraph      = unmarshalBool(s);
+
+   uint flags          = unmarshalFlags(s);
+   e->stat             = flags & (1 << 0);
+   e->explicitExternal = flags & (1 << 1);
+   e->proto            = flags & (1 << 2);
+   e->subGrouping      = flags & (1 << 3);
+   e->callGraph        = flags & (1 << 4);
+   e->callerGraph      = flags & (1 << 5);
+   e->hidden           = flags & (1 << 6);
+   e->artificial       = flags & (1 << 7);
+
    e->virt             = static_cast<Specifier>(unmarshalInt(s));
    e->args             = unmarshalQString(s);
    e->bitfields        = unmarshalQString(s);
@@ -542,8 +627,6 @@ QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
    e->startLine        = unmarshalInt(s);
    e->m_specialLists   = unmarshalItemInfoList(s);
    e->lang             = static_cast<SrcLangExt>(unmarshalInt(s));
-   e->hidden           = unmarshalBool(s);
-   e->artificial       = unmarshalBool(s);
    e->groupDocType     = static_cast<Entry::GroupDocType>(unmarshalInt(s));
    e->id               = unmarshalQString(s);
 
@@ -554,10 +637,20 @@ QSharedPointer<Entry> unmarshalEntryTree(StorageIntf *s)
 {
    QSharedPointer<Entry> e = unmarshalEntry(s);
 
+   if (! e) {
+      return e;
+   }
+
    uint count = unmarshalUInt(s);
 
    for (int i = 0; i < count; i++) {
-      e->addSubEntry(unmarshalEntryTree(s), e);
+      QSharedPointer<Entry> child = unmarshalEntryTree(s);
+
+      if (! child) {
+         return child;
+      }
+
+      e->addSubEntry(child, e);
    }
 
    return e;
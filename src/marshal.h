@@ -23,6 +23,8 @@
 #include <QString>
 #include <QVector>
 
+#include <initializer_list>
+
 #include <store.h>
 #include <section.h>
 
@@ -41,6 +43,7 @@ void marshalInt(StorageIntf *s,             int v);
 void marshalUInt(StorageIntf *s,            uint v);
 void marshalUInt64(StorageIntf *s,          uint64_t v);
 void marshalBool(StorageIntf *s,            bool b);
+void marshalFlags(StorageIntf *s,           std::initializer_list<bool> flags);
 void marshalObjPointer(StorageIntf *s,      void *obj);
 
 void marshalQByteArray(StorageIntf *s,      const QByteArray &str);
@@ -63,6 +66,7 @@ int                     unmarshalInt(StorageIntf *s);
 uint                    unmarshalUInt(StorageIntf *s);
 uint64_t                unmarshalUInt64(StorageIntf *s);
 bool                    unmarshalBool(StorageIntf *s);
+uint                    unmarshalFlags(StorageIntf *s);
 void                   *unmarshalObjPointer(StorageIntf *s);
 
 QByteArray              unmarshalQByteArray(StorageIntf *s);
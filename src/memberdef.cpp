@@ -37,6 +37,7 @@
 #include <outputlist.h>
 #include <parse_base.h>
 #include <objcache.h>
+#include <string_pool.h>
 #include <util.h>
 
 int MemberDef::s_indentLevel = 0;
@@ -710,7 +711,7 @@ void MemberDefImpl::init(Definition *def, const QString &t, const QString &a, co
       type = stripPrefix(type, "typedef ");
    }
 
-   type = removeRedundantWhiteSpace(type);
+   type = StringPool::intern(removeRedundantWhiteSpace(type));
 
    args = a;
    args = removeRedundantWhiteSpace(args);
@@ -3678,7 +3679,7 @@ QSharedPointer<MemberDef> MemberDef::createTemplateInstanceMember(const Argument
          m_impl->exception, m_impl->prot, m_impl->virt, m_impl->stat, m_impl->m_related, m_impl->mtype,
          ArgumentList(), ArgumentList());
 
-   imd->setArgumentList(actualArgList);
+   imd->setArgumentList(std::move(actualArgList));
    imd->setDefinition(substituteTemplateArgumentsInString(m_impl->def, formalArgs, actualArgs));
    imd->setBodyDef(getBodyDef());
    imd->setBodySegment(getStartBodyLine(), getEndBodyLine());
@@ -4145,14 +4146,14 @@ void MemberDef::writeEnumDeclaration(OutputList &typeDecl, QSharedPointer<ClassD
    }
 }
 
-void MemberDef::setArgumentList(const ArgumentList &al)
+void MemberDef::setArgumentList(ArgumentList al)
 {
-   m_impl->m_defArgList = al;
+   m_impl->m_defArgList = std::move(al);
 }
 
-void MemberDef::setDeclArgumentList(const ArgumentList &al)
+void MemberDef::setDeclArgumentList(ArgumentList al)
 {
-   m_impl->m_declArgList = al;
+   m_impl->m_declArgList = std::move(al);
 }
 
 void MemberDef::setTypeConstraints(const ArgumentList &al)
@@ -5204,17 +5205,10 @@ void MemberDef::copyArgumentNames(QSharedPointer<MemberDef> bmd)
    }
 }
 
-static void invalidateCachedTypesInArgumentList(ArgumentList &al)
-{
-   for (auto &a : al) {
-      a.canType = "";
-   }
-}
-
 void MemberDef::invalidateCachedArgumentTypes()
 {
-   invalidateCachedTypesInArgumentList(m_impl->m_defArgList);
-   invalidateCachedTypesInArgumentList(m_impl->m_declArgList);
+   m_impl->m_defArgList.clearCanonicalTypes();
+   m_impl->m_declArgList.clearCanonicalTypes();
 }
 
 QString MemberDef::displayName(bool unused) const
@@ -5298,7 +5292,7 @@ void combineDeclarationAndDefinition(QSharedPointer<MemberDef> mdec, QSharedPoin
             ArgumentList mdefAlComb = stringToArgumentList(mdef->argsString());
 
             transferArgumentDocumentation(mdefAl, mdefAlComb);
-            mdec->setArgumentList(mdefAlComb);
+            mdec->setArgumentList(std::move(mdefAlComb));
 
 
          } else if (! mdec->documentation().isEmpty()) {
@@ -5308,7 +5302,7 @@ void combineDeclarationAndDefinition(QSharedPointer<MemberDef> mdec, QSharedPoin
             ArgumentList mdecAlComb = stringToArgumentList(mdec->argsString());
 
             transferArgumentDocumentation(mdecAl, mdecAlComb);
-            mdef->setDeclArgumentList(mdecAlComb);
+            mdef->setDeclArgumentList(std::move(mdecAlComb));
 
          }
 
@@ -237,8 +237,8 @@ class MemberDef : public Definition
    bool isPrototype() const;
 
    // argument related members
-   void setArgumentList(const ArgumentList &al);
-   void setDeclArgumentList(const ArgumentList &al);
+   void setArgumentList(ArgumentList al);
+   void setDeclArgumentList(ArgumentList al);
    void setTypeConstraints(const ArgumentList &al);
    void setTemplateParameterLists(const QVector<ArgumentList> &lists);
 
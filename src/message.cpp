@@ -50,6 +50,8 @@ QHash<QString, Debug::DebugMask> debugMap()
    tempMap.insert("markdown",     Debug::Markdown     );
    tempMap.insert("filteroutput", Debug::FilterOutput );  
    tempMap.insert("lex",          Debug::Lex          );    
+   tempMap.insert("access",       Debug::Access       );
+   tempMap.insert("overloads",    Debug::Overloads    );
 
    return tempMap;
 }
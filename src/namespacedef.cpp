@@ -749,6 +749,7 @@ void NamespaceDef::addUsingDirective(QSharedPointer<NamespaceDef> nd)
 {
    if (m_usingDirMap.find(nd->qualifiedName()) == 0) {
       m_usingDirMap.insert(nd->qualifiedName(), nd);
+      invalidateAccessIndex();
    }
 }
 
@@ -761,6 +762,7 @@ void NamespaceDef::addUsingDeclaration(QSharedPointer<Definition> d)
 {
    if (m_usingDeclMap.find(d->qualifiedName()) == 0) {
       m_usingDeclMap.insert(d->qualifiedName(), d);
+      invalidateAccessIndex();
    }
 }
 
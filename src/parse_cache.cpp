@@ -0,0 +1,210 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+
+#include <parse_cache.h>
+
+#include <config.h>
+#include <doxy_build_info.h>
+#include <entry.h>
+#include <filestorage.h>
+#include <marshal.h>
+#include <message.h>
+
+#define PARSE_CACHE_MAGIC   ('D'<<24)+('P'<<16)+('C'<<8)+'!'
+#define PARSE_CACHE_VERSION 3
+
+// configuration options which change the entries produced by the preprocessor, the comment
+// converter, the comment scanner or the language parsers
+static const char *const cacheBoolOptions[] = {
+   "optimize-cplus", "optimize-java", "optimize-c", "optimize-fortran", "optimize-python",
+   "javadoc-auto-brief", "qt-auto-brief", "multiline-cpp-brief",
+   "extract-all", "extract-private", "extract-package", "extract-static",
+   "extract-local-classes", "extract-local-methods", "extract-anon-namespaces",
+   "hide-in-body-docs", "markdown", "internal-docs", "bb-style",
+   "built-in-stl-support", "cpp-cli-support", "sip-support", "idl-support",
+   "generate-todo-list", "generate-test-list", "generate-bug-list", "generate-deprecate-list",
+   "enable-preprocessing", "search-includes", "macro-expansion", "expand-only-predefined",
+   "skip-function-macros", "strip-code-comments", "source-code",
+   nullptr
+};
+
+static const char *const cacheListOptions[] = {
+   "aliases", "enabled-sections", "tcl-subst", "language-mapping", "filter-patterns",
+   "include-path", "include-patterns", "predefined-macros", "expand-as-defined", "ns-alias",
+   nullptr
+};
+
+static const char *const cacheStringOptions[] = {
+   "input-encoding", "filter-program",
+   nullptr
+};
+
+ParseCache::ParseCache()
+   : m_enabled(false), m_hits(0), m_misses(0), m_skipped(0)
+{
+}
+
+ParseCache *ParseCache::instance()
+{
+   static ParseCache instance;
+   return &instance;
+}
+
+void ParseCache::initialize(const QString &outputDir)
+{
+   static const bool parseCache   = Config::getBool("parse-cache");
+   static const bool clangParsing = Config::getBool("clang-parsing");
+
+   if (! parseCache || clangParsing) {
+      // entries created by clang depend on the whole translation unit
+      return;
+   }
+
+   m_cacheDir = outputDir + "/doxy_parse_cache";
+
+   QDir dir(m_cacheDir);
+
+   if (! dir.exists() && ! dir.mkpath(m_cacheDir)) {
+      warn_uncond("Unable to create parse cache directory %s, parse cache is disabled\n", csPrintable(m_cacheDir));
+      return;
+   }
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(versionString);
+   hash.addData(QByteArray::number(PARSE_CACHE_VERSION));
+   hash.addData(Config::getEnum("output-language").toUtf8());
+   hash.addData(QByteArray::number(Config::getInt("tab-size")));
+
+   for (int i = 0; cacheBoolOptions[i] != nullptr; ++i) {
+      hash.addData(Config::getBool(cacheBoolOptions[i]) ? "1" : "0");
+   }
+
+   for (int i = 0; cacheListOptions[i] != nullptr; ++i) {
+      hash.addData(Config::getList(cacheListOptions[i]).join("\n").toUtf8());
+      hash.addData("\0", 1);
+   }
+
+   for (int i = 0; cacheStringOptions[i] != nullptr; ++i) {
+      hash.addData(Config::getString(cacheStringOptions[i]).toUtf8());
+      hash.addData("\0", 1);
+   }
+
+   m_configHash = hash.result();
+   m_enabled    = true;
+}
+
+QByteArray ParseCache::computeKey(const QString &fileName, enum ParserMode mode, const QString &fileContents) const
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(m_configHash);
+   hash.addData(fileName.toUtf8());
+   hash.addData(QByteArray::number(mode));
+   hash.addData(fileContents.toUtf8());
+
+   return hash.result();
+}
+
+QString ParseCache::recordName(const QString &fileName) const
+{
+   QByteArray sigStr = QCryptographicHash::hash(fileName.toUtf8(), QCryptographicHash::Md5).toHex();
+   return m_cacheDir + "/" + QString::fromLatin1(sigStr) + ".cache";
+}
+
+QSharedPointer<Entry> ParseCache::restore(const QString &fileName, const QByteArray &key, int &anonNSDelta)
+{
+   QSharedPointer<Entry> retval;
+
+   QString recName = recordName(fileName);
+
+   if (! QFile::exists(recName)) {
+      ++m_misses;
+      return retval;
+   }
+
+   FileStorage storage(recName);
+
+   if (! storage.open(QIODevice::ReadOnly)) {
+      ++m_misses;
+      return retval;
+   }
+
+   uint magic   = unmarshalUInt(&storage);
+   uint version = unmarshalUInt(&storage);
+
+   if (magic == PARSE_CACHE_MAGIC && version == PARSE_CACHE_VERSION && unmarshalQByteArray(&storage) == key) {
+      anonNSDelta = unmarshalInt(&storage);
+      retval      = unmarshalEntryTree(&storage);
+   }
+
+   storage.close();
+
+   if (retval) {
+      ++m_hits;
+   } else {
+      ++m_misses;
+   }
+
+   return retval;
+}
+
+void ParseCache::store(const QString &fileName, const QByteArray &key, QSharedPointer<Entry> root, int anonNSDelta)
+{
+   QString recName = recordName(fileName);
+   QString tmpName = recName + ".tmp";
+
+   FileStorage storage(tmpName);
+
+   if (! storage.open(QIODevice::WriteOnly)) {
+      return;
+   }
+
+   marshalUInt(&storage, PARSE_CACHE_MAGIC);
+   marshalUInt(&storage, PARSE_CACHE_VERSION);
+   marshalQByteArray(&storage, key);
+   marshalInt(&storage, anonNSDelta);
+   marshalEntryTree(&storage, root);
+
+   storage.close();
+
+   // replace the old record only once the new one is complete
+   QFile::remove(recName);
+
+   if (! QFile::rename(tmpName, recName)) {
+      QFile::remove(tmpName);
+   }
+}
+
+void ParseCache::skip(const QString &fileName)
+{
+   ++m_skipped;
+
+   // an old record for this file is no longer valid
+   QFile::remove(recordName(fileName));
+}
+
+void ParseCache::printStatistics() const
+{
+   if (m_enabled) {
+      msg("Parse cache: %d files restored, %d files parsed, %d files not cacheable\n", m_hits, m_misses, m_skipped);
+   }
+}
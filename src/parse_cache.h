@@ -0,0 +1,83 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef PARSE_CACHE_H
+#define PARSE_CACHE_H
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QString>
+
+#include <parse_base.h>
+
+class Entry;
+
+/** \brief Persistent cache of the entry trees produced by parsing an input file
+ *
+ *  A record is stored in the output directory for every input file which was parsed. The
+ *  record is keyed by a hash of the file name, the parser mode, the preprocessed file contents
+ *  and the configuration options which influence the parsers. When the key of a later run
+ *  matches, the marshaled entry tree is restored and the file is not parsed again.
+ *
+ *  Files whose parsing modified global state (sections, formulas, cross reference lists,
+ *  member groups, anonymous scope names) are never stored since replaying the entry tree
+ *  would not reproduce these changes. The anonymous namespace counter is stored with the record
+ *  and advanced when the record is restored.
+ */
+class ParseCache
+{
+ public:
+   static ParseCache *instance();
+
+   // sets up the cache directory, does nothing if the cache is disabled
+   void initialize(const QString &outputDir);
+
+   bool isEnabled() const {
+      return m_enabled;
+   }
+
+   // returns the key for the given file, fileContents are the preprocessed contents
+   QByteArray computeKey(const QString &fileName, enum ParserMode mode, const QString &fileContents) const;
+
+   // returns the cached entry tree or a null pointer if there is no valid record for key
+   // anonNSDelta is set to the number of anonymous namespace names used while the file was parsed
+   QSharedPointer<Entry> restore(const QString &fileName, const QByteArray &key, int &anonNSDelta);
+
+   // stores the entry tree parsed from fileName
+   void store(const QString &fileName, const QByteArray &key, QSharedPointer<Entry> root, int anonNSDelta);
+
+   // called when the entry tree of fileName can not be stored
+   void skip(const QString &fileName);
+
+   void printStatistics() const;
+
+ private:
+   ParseCache();
+
+   QString recordName(const QString &fileName) const;
+
+   bool m_enabled;
+
+   QString    m_cacheDir;
+   QByteArray m_configHash;
+
+   int m_hits;
+   int m_misses;
+   int m_skipped;
+};
+
+#endif
@@ -16,14 +16,26 @@
 *************************************************************************/
 
 #include <QByteArray>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
 #include <QHash>
+#include <QMutex>
 #include <QSet>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
 
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <clang-c/CXCompilationDatabase.h>
 
 #include <parse_clang.h>
 
+#include <commentcnv.h>
 #include <commentscan.h>
 #include <config.h>
 #include <doxy_globals.h>
@@ -47,28 +59,76 @@ static uint g_bracketCount   = 0;
 static bool g_searchForBody  = false;
 static bool g_insideBody     = false;
 
-QSharedPointer<Entry>                s_current_root;
-QMap<QString, QSharedPointer<Entry>> s_entryMap;
+// entries of the current translation unit by clang USR
+static QMap<QString, QSharedPointer<Entry>> s_entryMap;
 
 static void writeLineNumber(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint line);
 
+class ClangTuQueue;
+class ClangWorkerThread;
+
+/** @brief Files passed to clang for one translation unit
+ */
+struct ClangSourceFiles
+{
+   // contents of the files in ufs, shared with other translation units
+   QVector<QSharedPointer<QByteArray>> sources;
+   QVector<QByteArray>    names;
+   QVector<CXUnsavedFile> ufs;
+
+   // length of every file in the translation unit, including files clang reads from disk
+   QHash<QString, uint> fileLength;
+};
+
+/** @brief Token of a source file with the annotation required to write the source code
+ */
+struct ClangToken
+{
+   uint line;
+   uint column;
+
+   CXTokenKind  tokenKind;
+   CXCursorKind cursorKind;
+
+   // position of the token text in ClangTokenTable::source
+   uint offset;
+   uint length;
+
+   // index in ClangTokenTable::usrList of the symbol this token refers to, -1 if not required
+   int usr;
+};
+
+/** @brief Tokens of a file saved while parsing the translation unit, used to write the
+ *  source code without parsing the translation unit a second time
+ */
+struct ClangTokenTable
+{
+   QString text(const ClangToken &token) const {
+      return QString::fromUtf8(source->constData() + token.offset, token.length);
+   }
+
+   QVector<ClangToken> tokens;
+   QStringList usrList;
+
+   // contents of the file, shared with the translation unit which was parsed
+   QSharedPointer<QByteArray> source;
+};
+
 class ClangParser::Private
 {
  public:
    enum DetectedLang { Detected_Cpp, Detected_ObjC, Detected_ObjCpp };
 
    Private()
-      : tu(0), tokens(0), numTokens(0), cursors(0), ufs(0), sources(0), numFiles(0),
-        fileMapping(), detectedLang(Detected_Cpp)
+      : index(0), tu(0), tokens(0), numTokens(0), cursors(0), detectedLang(Detected_Cpp), queue(nullptr),
+        captureTokens(false), forceParse(false), tuCount(0)
    {
    }
 
    int getCurrentTokenLine();
 
    QString fileName;
-   QByteArray *sources;
 
-   uint numFiles;
    uint numTokens;
    uint curLine;
    uint curToken;
@@ -77,10 +137,108 @@ class ClangParser::Private
    CXTranslationUnit  tu;
    CXToken           *tokens;
    CXCursor          *cursors;
-   CXUnsavedFile     *ufs;
 
-   QHash<QString, uint> fileMapping;
+   ClangSourceFiles files;
    DetectedLang detectedLang;
+
+   // translation units parsed ahead by worker threads
+   ClangTuQueue *queue;
+   QList<ClangWorkerThread *> workers;
+
+   // tokens saved while parsing, written by writeSources()
+   QHash<QString, QSharedPointer<ClangTokenTable>> tokenTables;
+   QSharedPointer<ClangTokenTable> currentTable;
+   bool captureTokens;
+
+   // translation unit which is only parsed if a file without saved tokens is written
+   QString     pendingFile;
+   QStringList pendingIncludes;
+   bool forceParse;
+
+   // number of translation units started for entry extraction
+   int tuCount;
+};
+
+/** @brief Translation unit parsed by libclang, owns the index and the files passed to clang
+ */
+struct ClangTuState
+{
+   QString     fileName;
+   QStringList includeFiles;
+
+   ClangParser::Private::DetectedLang detectedLang = ClangParser::Private::Detected_Cpp;
+
+   ClangSourceFiles files;
+
+   // converted source of the main file, taken by Doxy_Work::parseFile() to avoid converting it again
+   QString buffer;
+
+   // precompiled header used to parse this translation unit
+   QString pchName;
+
+   CXIndex           index     = 0;
+   CXTranslationUnit tu        = 0;
+   CXErrorCode       errorCode = CXError_Failure;
+
+   // entries created by libTooling
+   int  tuIndex       = 0;
+   bool entriesParsed = false;
+   DoxyToolingResult entries;
+};
+
+/** @brief Translation units which are parsed by worker threads, taken in order by ClangParser::start()
+ */
+class ClangTuQueue
+{
+ public:
+   ClangTuQueue(const QVector<ClangTuState *> &list, int maxReadAhead);
+   ~ClangTuQueue();
+
+   // called from a worker thread, returns the next translation unit or a nullptr when done
+   ClangTuState *dequeue();
+   void setParsed(ClangTuState *state);
+
+   // called from the main thread, returns the next translation unit whose sources need to be loaded
+   ClangTuState *nextToLoad();
+   void setLoaded();
+
+   // called from the main thread, returns true if the sources of fileName were loaded
+   bool takeBuffer(const QString &fileName, QString &buffer);
+
+   // called from the main thread, returns the parsed translation unit or a nullptr if not scheduled
+   ClangTuState *take(const QString &fileName);
+
+   void stop();
+
+ private:
+   QVector<ClangTuState *> m_states;
+   QVector<bool> m_parsed;
+
+   int  m_nextIndex;
+   int  m_consumed;
+   int  m_loaded;
+   int  m_maxReadAhead;
+   bool m_stop;
+
+   QMutex m_mutex;
+   QWaitCondition m_tuParsed;
+   QWaitCondition m_tuAvailable;
+};
+
+/** @brief Worker thread which parses translation units with its own clang index
+ */
+class ClangWorkerThread : public QThread
+{
+ public:
+   ClangWorkerThread(ClangTuQueue *queue)
+      : m_queue(queue)
+   {
+   }
+
+   void run() override;
+
+ private:
+   ClangTuQueue *m_queue;
 };
 
 int ClangParser::Private::getCurrentTokenLine()
@@ -363,278 +521,1364 @@ static QString keywordToType(const QString &key)
    return "keyword";
 }
 
-static void writeLineNumber(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint line)
+static void writeLineNumber(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint line)
+{
+   QSharedPointer<Definition> d;
+
+   if (fd) {
+      d = fd->getSourceDefinition(line);
+   }
+
+   if (d && d->isLinkable()) {
+      s_currentDefinition = d;
+      g_currentLine = line;
+
+      QSharedPointer<MemberDef> md = fd->getSourceMember(line);
+
+      if (md && md->isLinkable()) {
+         // link to member
+
+         if (s_currentMemberDef != md) {
+            // new member, start search for body
+
+            g_searchForBody = true;
+            g_insideBody    = false;
+            g_bracketCount  = 0;
+         }
+
+         s_currentMemberDef = md;
+         ol.writeLineNumber(md->getReference(), md->getOutputFileBase(), md->anchor(), line);
+
+      } else {
+         // link to compound
+         s_currentMemberDef = QSharedPointer<MemberDef>();
+         ol.writeLineNumber(d->getReference(), d->getOutputFileBase(), d->anchor(), line);
+      }
+
+   } else {
+      // no link
+      ol.writeLineNumber(0, 0, 0, line);
+   }
+
+   // set search page target
+   if (Doxy_Globals::searchIndexBase != nullptr) {
+      QString lineAnchor = QString("l%1").arg(line, 5, 10, QChar('0'));
+      ol.setCurrentDoc(fd, lineAnchor, true);
+   }
+}
+
+static void writeMultiLineCodeLink(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint &line, uint &column,
+                  QSharedPointer<Definition> d, const QString &text)
+{
+   static bool sourceTooltips = Config::getBool("source-tooltips");
+   TooltipManager::instance()->addTooltip(d);
+
+   QString ref    = d->getReference();
+   QString file   = d->getOutputFileBase();
+   QString anchor = d->anchor();
+
+   QString tooltip;
+
+   if (! sourceTooltips) {
+      // fall back to simple "title" tooltips
+      tooltip = d->briefDescriptionAsTooltip();
+   }
+
+   QString tmp;
+
+   for (auto c : text) {
+
+      if (c == '\n') {
+         line++;
+
+         ol.writeCodeLink(ref, file, anchor, tmp, tooltip);
+         ol.endCodeLine();
+
+         ol.startCodeLine(true);
+         writeLineNumber(ol, fd, line);
+
+         tmp = "";
+
+      } else {
+         column++;
+         tmp += c;
+
+      }
+   }
+
+   if (! tmp.isEmpty() )  {
+      ol.writeCodeLink(ref, file, anchor, tmp, tooltip);
+   }
+}
+
+// call back, called for each include in a translation unit
+static void inclusionVisitor(CXFile file, CXSourceLocation *, uint, CXClientData clientData)
+{
+   s_includedFiles.insert(getFileName(file));
+}
+
+static bool documentKind(CXCursor cursor)
+{
+   CXCursorKind kind = clang_getCursorKind(cursor);
+
+   if (kind == CXCursor_FunctionDecl       ||
+       kind == CXCursor_FunctionTemplate   ||
+       kind == CXCursor_ClassDecl          ||
+       kind == CXCursor_ClassTemplate      ||
+       kind == CXCursor_StructDecl         ||
+       kind == CXCursor_Constructor        ||
+       kind == CXCursor_Destructor         ||
+       kind == CXCursor_ConversionFunction ||
+       kind == CXCursor_UnionDecl          ||
+       kind == CXCursor_EnumDecl           ||
+       kind == CXCursor_EnumConstantDecl   ||
+       kind == CXCursor_FieldDecl          ||
+       kind == CXCursor_ParmDecl           ||
+       kind == CXCursor_VarDecl            ||
+       kind == CXCursor_CXXMethod          ||
+       kind == CXCursor_TypedefDecl        ||
+       kind == CXCursor_TypeAliasDecl      ||
+       kind == CXCursor_UnexposedDecl      ||
+       kind == CXCursor_MacroDefinition    ||
+       kind == CXCursor_Namespace    )  {
+
+      return true;
+   }
+
+   return false;
+}
+
+// arguments passed to clang for every translation unit
+static std::vector<std::string> clangBaseArguments()
+{
+   static QStringList const includePath      = Config::getList("include-path");
+   static QStringList const clangFlags       = Config::getList("clang-flags");
+   static QStringList const preDefinedMacros = Config::getList("predefined-macros");
+
+   std::vector<std::string> argList;
+
+   // add include paths for input files
+   for (auto &item : Doxy_Globals::inputPaths) {
+      std::string inc = std::string("-I") + item.toUtf8().constData();
+      argList.push_back(std::move(inc));
+   }
+
+   // add external include paths
+   for (auto &item : includePath) {
+      std::string inc = std::string("-I") + item.toUtf8().constData();
+      argList.push_back(std::move(inc));
+   }
+
+   // add predefinded macros
+   for (const auto &item : preDefinedMacros) {
+      std::string macro = std::string("-D") + item.toUtf8().constData();
+      argList.push_back(std::move(macro));
+   }
+
+   // user specified flags
+   for (auto &item : clangFlags) {
+      argList.push_back(item.toUtf8().constData());
+   }
+
+   argList.push_back("-ferror-limit=0");
+   argList.push_back("-x");
+
+   return argList;
+}
+
+static std::string clangLanguageName(ClangParser::Private::DetectedLang lang)
+{
+   switch (lang) {
+      case ClangParser::Private::Detected_ObjC:
+         return "objective-c";
+
+      case ClangParser::Private::Detected_ObjCpp:
+         return "objective-c++";
+
+      default:
+         return "c++";
+   }
+}
+
+static void pchInclusionVisitor(CXFile file, CXSourceLocation *, uint, CXClientData clientData)
+{
+   QSet<QString> *files = static_cast<QSet<QString> *>(clientData);
+   files->insert(QFileInfo(getFileName(file)).absoluteFilePath());
+}
+
+// builds a precompiled header for the prefix header in clang-pch-header, the pch is stored in the output
+// directory and reused by later runs as long as the clang version, the arguments and the header do not change
+// pchFiles is set to the files read while building the pch, these are listed in a ".files" file next to the pch
+static QString buildPrecompiledHeader(const QString &headerName, ClangParser::Private::DetectedLang lang,
+                  QSet<QString> &pchFiles)
+{
+   static const QString outputDir = Config::getString("output-dir");
+
+   std::vector<std::string> argList = clangBaseArguments();
+   argList.push_back(clangLanguageName(lang) + "-header");
+   argList.push_back(headerName.toUtf8().constData());
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   CXString version = clang_getClangVersion();
+   hash.addData(clang_getCString(version));
+   clang_disposeString(version);
+
+   for (const auto &item : argList) {
+      hash.addData(item.c_str(), item.size() + 1);
+   }
+
+   QFile headerFile(headerName);
+
+   if (headerFile.open(QIODevice::ReadOnly)) {
+      hash.addData(headerFile.readAll());
+      headerFile.close();
+   }
+
+   QByteArray key = hash.result().toHex();
+
+   QString pchDir = outputDir + "/doxy_clang_pch";
+   QDir dir(pchDir);
+
+   if (! dir.exists() && ! dir.mkpath(pchDir)) {
+      warn_uncond("Unable to create directory %s, precompiled header is not used\n", csPrintable(pchDir));
+      return QString();
+   }
+
+   QString pchName = pchDir + "/prefix_" + QString::fromUtf8(clangLanguageName(lang).c_str()).replace("+", "x") + ".pch";
+   QFile keyFile(pchName + ".key");
+   QFile listFile(pchName + ".files");
+
+   if (QFile::exists(pchName) && keyFile.open(QIODevice::ReadOnly)) {
+      QByteArray oldKey = keyFile.readAll();
+      keyFile.close();
+
+      if (oldKey == key && listFile.open(QIODevice::ReadOnly)) {
+         // reuse pch from a previous run
+         for (const auto &item : QString::fromUtf8(listFile.readAll()).split("\n")) {
+            if (! item.isEmpty()) {
+               pchFiles.insert(item);
+            }
+         }
+
+         listFile.close();
+
+         return pchName;
+      }
+   }
+
+   QFile::remove(keyFile.fileName());
+   QFile::remove(listFile.fileName());
+
+   std::vector<const char *> argv;
+   for (auto &item : argList) {
+      argv.push_back(item.c_str());
+   }
+
+   msg("Building precompiled header for %s\n", csPrintable(headerName));
+
+   CXIndex index = clang_createIndex(false, false);
+   CXTranslationUnit tu = 0;
+
+   CXErrorCode errorCode = clang_parseTranslationUnit2(index, 0, &argv[0], argv.size(), 0, 0,
+                  CXTranslationUnit_Incomplete | CXTranslationUnit_ForSerialization, &tu);
+
+   QString retval;
+
+   if (tu && errorCode == CXError_Success) {
+
+      if (clang_saveTranslationUnit(tu, pchName.toUtf8().constData(), clang_defaultSaveOptions(tu)) == CXSaveError_None) {
+         clang_getInclusions(tu, pchInclusionVisitor, &pchFiles);
+
+         if (listFile.open(QIODevice::WriteOnly)) {
+            for (const auto &item : pchFiles) {
+               listFile.write(item.toUtf8() + "\n");
+            }
+
+            listFile.close();
+
+            if (keyFile.open(QIODevice::WriteOnly)) {
+               keyFile.write(key);
+               keyFile.close();
+            }
+         }
+
+         retval = pchName;
+      }
+   }
+
+   if (tu) {
+      clang_disposeTranslationUnit(tu);
+   }
+
+   clang_disposeIndex(index);
+
+   if (retval.isEmpty()) {
+      warn_uncond("Unable to build a precompiled header for %s\n", csPrintable(headerName));
+   }
+
+   return retval;
+}
+
+// returns the precompiled header used to parse fileName as lang or an empty string if not used, headers and
+// files read by the pch are parsed without it since their include guards are already defined by the pch
+// worker threads may call this concurrently
+static QString precompiledHeader(const QString &fileName, ClangParser::Private::DetectedLang lang, bool rebuild = false)
+{
+   static const QString pchHeader = Config::getString("clang-pch-header");
+
+   if (pchHeader.isEmpty() || determineSection(fileName) == Entry::HEADER_SEC) {
+      return QString();
+   }
+
+   static QMutex pchMutex;
+   static QHash<int, QString> pchNames;
+   static QHash<int, QSet<QString>> pchFiles;
+   static QSet<int> pchRebuilt;
+
+   QMutexLocker locker(&pchMutex);
+
+   if (rebuild) {
+      if (pchRebuilt.contains(lang)) {
+         // already rebuilt during this run, do not use the pch
+         pchNames.insert(lang, QString());
+         return QString();
+      }
+
+      pchRebuilt.insert(lang);
+
+      QString oldName = pchNames.value(lang);
+
+      if (! oldName.isEmpty()) {
+         QFile::remove(oldName + ".key");
+      }
+
+      pchNames.remove(lang);
+      pchFiles.remove(lang);
+   }
+
+   auto iter = pchNames.find(lang);
+
+   if (iter != pchNames.end()) {
+      if (pchFiles.value(lang).contains(QFileInfo(fileName).absoluteFilePath())) {
+         return QString();
+      }
+
+      return iter.value();
+   }
+
+   QFileInfo fi(pchHeader);
+
+   if (! fi.isAbsolute()) {
+      fi = QFileInfo(Config::getConfigDir(), pchHeader);
+   }
+
+   QString retval;
+   QSet<QString> &files = pchFiles[lang];
+
+   if (fi.exists() && fi.isFile()) {
+      retval = buildPrecompiledHeader(fi.absoluteFilePath(), lang, files);
+
+   } else {
+      warn_uncond("Precompiled header source %s was not found\n", csPrintable(fi.absoluteFilePath()));
+
+   }
+
+   pchNames.insert(lang, retval);
+
+   if (files.contains(QFileInfo(fileName).absoluteFilePath())) {
+      return QString();
+   }
+
+   return retval;
+}
+
+// arguments of the compile command in compile_commands.json without the compiler, the output
+// and the source file, relative paths are resolved using the directory of the command
+static std::vector<std::string> compileCommandArguments(CXCompileCommand command, const QString &fileName)
+{
+   static const QStringList pathOptions = { "-I", "-F", "-isystem", "-iquote", "-idirafter", "-include", "-imacros" };
+
+   CXString text     = clang_CompileCommand_getDirectory(command);
+   QString directory = QString::fromUtf8(clang_getCString(text));
+   clang_disposeString(text);
+
+   auto absolutePath = [&directory] (const QString &path) {
+      if (path.isEmpty() || QDir::isAbsolutePath(path)) {
+         return path;
+      }
+
+      return QDir::cleanPath(directory + "/" + path);
+   };
+
+   std::vector<std::string> argList;
+   uint numArgs = clang_CompileCommand_getNumArgs(command);
+
+   // first argument is the compiler
+   for (uint i = 1; i < numArgs; ++i) {
+      text = clang_CompileCommand_getArg(command, i);
+      QString arg = QString::fromUtf8(clang_getCString(text));
+      clang_disposeString(text);
+
+      if (arg == "-c" || arg == "-MD" || arg == "-MMD") {
+         continue;
+
+      } else if (arg == "-o" || arg == "-MF" || arg == "-MT" || arg == "-MQ") {
+         // skip the option and its value
+         ++i;
+         continue;
+
+      } else if (arg.startsWith("-o") || arg.startsWith("-MF")) {
+         continue;
+
+      } else if (pathOptions.contains(arg) && i + 1 < numArgs) {
+         argList.push_back(arg.toUtf8().constData());
+
+         text = clang_CompileCommand_getArg(command, ++i);
+         arg  = absolutePath(QString::fromUtf8(clang_getCString(text)));
+         clang_disposeString(text);
+
+      } else if (arg.startsWith("-I") || arg.startsWith("-F")) {
+         arg = arg.left(2) + absolutePath(arg.mid(2));
+
+      } else if (! arg.startsWith("-") && absolutePath(arg) == fileName) {
+         // source file is added by the caller
+         continue;
+
+      }
+
+      argList.push_back(arg.toUtf8().constData());
+   }
+
+   return argList;
+}
+
+// looks up fileName in compile_commands.json of clang-compilation-path, returns false if there is
+// no compile command for this file, worker threads may call this concurrently
+static bool compilationDatabaseArguments(const QString &fileName, std::vector<std::string> &argList)
+{
+   static const QString compilationPath = Config::getString("clang-compilation-path");
+
+   if (compilationPath.isEmpty()) {
+      return false;
+   }
+
+   static QMutex dbMutex;
+   static CXCompilationDatabase database = nullptr;
+   static bool loaded = false;
+   static QHash<QString, std::vector<std::string>> commands;
+
+   QMutexLocker locker(&dbMutex);
+
+   if (! loaded) {
+      loaded = true;
+
+      QFileInfo fi(compilationPath);
+
+      if (! fi.isAbsolute()) {
+         fi = QFileInfo(Config::getConfigDir(), compilationPath);
+      }
+
+      CXCompilationDatabase_Error error;
+      database = clang_CompilationDatabase_fromDirectory(fi.absoluteFilePath().toUtf8().constData(), &error);
+
+      if (error != CXCompilationDatabase_NoError) {
+         warn_uncond("Unable to load compile_commands.json from %s, clang-flags will be used\n",
+                  csPrintable(fi.absoluteFilePath()));
+
+         if (database != nullptr) {
+            clang_CompilationDatabase_dispose(database);
+            database = nullptr;
+         }
+      }
+   }
+
+   if (database == nullptr) {
+      return false;
+   }
+
+   auto iter = commands.find(fileName);
+
+   if (iter == commands.end()) {
+      std::vector<std::string> fileArgs;
+      CXCompileCommands fileCommands = clang_CompilationDatabase_getCompileCommands(database, fileName.toUtf8().constData());
+
+      if (fileCommands != nullptr) {
+         if (clang_CompileCommands_getSize(fileCommands) > 0) {
+            // a file which is built more than once is only parsed with the first command
+            fileArgs = compileCommandArguments(clang_CompileCommands_getCommand(fileCommands, 0), fileName);
+         }
+
+         clang_CompileCommands_dispose(fileCommands);
+      }
+
+      iter = commands.insert(fileName, fileArgs);
+   }
+
+   if (iter.value().empty()) {
+      return false;
+   }
+
+   argList = iter.value();
+
+   return true;
+}
+
+static std::vector<std::string> clangArguments(const QString &fileName, ClangParser::Private::DetectedLang lang,
+                  const QString &pchName = QString())
+{
+   static const QStringList clangFlags = Config::getList("clang-flags");
+
+   // the first arguments do not change, computed once
+   static const std::vector<std::string> clangCmdArgs = clangBaseArguments();
+
+   std::vector<std::string> dbArgList;
+
+   if (compilationDatabaseArguments(fileName, dbArgList)) {
+      // use the flags the file is compiled with, a precompiled header built with other flags is not used
+
+      for (auto &item : clangFlags) {
+         dbArgList.push_back(item.toUtf8().constData());
+      }
+
+      dbArgList.push_back("-ferror-limit=0");
+      dbArgList.push_back(fileName.toUtf8().constData());
+
+      return dbArgList;
+   }
+
+   std::vector<std::string> argList = clangCmdArgs;
+   argList.push_back(clangLanguageName(lang));
+
+   if (! pchName.isEmpty()) {
+      argList.push_back("-include-pch");
+      argList.push_back(pchName.toUtf8().constData());
+   }
+
+   argList.push_back(fileName.toUtf8().constData());
+
+   return argList;
+}
+
+// language used for fileName, lang is the language of the previous translation unit
+static ClangParser::Private::DetectedLang detectLanguage(const QString &fileName, ClangParser::Private::DetectedLang lang)
+{
+   // if the file is an .h file it can contain C, C++, or Objective C  (review)
+   // detection will fail if we pass .h files containing ObjC code and no source
+
+   SrcLangExt srcLang = getLanguageFromFileName(fileName);
+
+   if (srcLang == SrcLangExt_ObjC || lang != ClangParser::Private::Detected_Cpp) {
+      QFileInfo fi(fileName);
+      QString ext = fi.suffix().toLower();
+
+      if (lang == ClangParser::Private::Detected_Cpp &&
+            (ext == "cpp" || ext == "cxx" || ext == "cc" || ext == "c")) {
+
+         // fall back to C/C++ once we see an extension that indicates C++
+         lang = ClangParser::Private::Detected_Cpp;
+
+      } else if (ext == "mm") {
+         // switch to Objective C++
+         lang = ClangParser::Private::Detected_ObjCpp;
+
+      } else if (ext == "m") {
+         // switch to Objective C
+         lang = ClangParser::Private::Detected_ObjC;
+      }
+   }
+
+   return lang;
+}
+
+/** @brief Contents of a file as clang should see it
+ */
+struct ClangSourceFile
+{
+   // nullptr if the file on disk can be used as is
+   QSharedPointer<QByteArray> contents;
+   uint length = 0;
+};
+
+// files already loaded during this run, shared by all translation units
+static QMutex s_sourceFileMutex;
+static QHash<QString, ClangSourceFile> s_sourceFiles;
+
+static ClangSourceFile loadSourceFile(const QString &fileName)
+{
+   static bool filterSourceFiles = Config::getBool("filter-source-files");
+
+   {
+      QMutexLocker locker(&s_sourceFileMutex);
+
+      auto iter = s_sourceFiles.find(fileName);
+
+      if (iter != s_sourceFiles.end()) {
+         return iter.value();
+      }
+   }
+
+   QByteArray data = detab(fileToString(fileName, filterSourceFiles, true)).toUtf8();
+
+   ClangSourceFile item;
+   item.length = data.length();
+
+   QFile file(fileName);
+
+   if (file.open(QIODevice::ReadOnly) && file.size() == data.size() && file.readAll() == data) {
+      // no filtering, encoding or tab conversion was required
+
+   } else {
+      item.contents = QMakeShared<QByteArray>(data);
+
+   }
+
+   QMutexLocker locker(&s_sourceFileMutex);
+
+   auto iter = s_sourceFiles.find(fileName);
+
+   if (iter == s_sourceFiles.end()) {
+      iter = s_sourceFiles.insert(fileName, item);
+   }
+
+   return iter.value();
+}
+
+static void addUnsavedFile(ClangSourceFiles &files, const QString &fileName, QSharedPointer<QByteArray> contents)
+{
+   files.sources.append(contents);
+   files.names.append(fileName.toUtf8());
+
+   CXUnsavedFile ufs;
+   ufs.Filename = nullptr;
+   ufs.Contents = contents->constData();
+   ufs.Length   = contents->length();
+
+   files.ufs.append(ufs);
+   files.fileLength.insert(fileName, contents->length());
+}
+
+// provide the input and the files it includes to clang
+static void loadUnsavedFiles(ClangTuState *state, const QString &fileBuffer)
+{
+   static bool filterSourceFiles = Config::getBool("filter-source-files");
+
+   ClangSourceFiles &files = state->files;
+
+   // load main file
+   QSharedPointer<QByteArray> mainSource;
+
+   if (fileBuffer.isEmpty()) {
+      mainSource = QMakeShared<QByteArray>(detab(fileToString(state->fileName, filterSourceFiles, true)).toUtf8());
+   } else  {
+      mainSource = QMakeShared<QByteArray>(fileBuffer.toUtf8());
+   }
+
+   addUnsavedFile(files, state->fileName, mainSource);
+
+   // load include files, files which do not need to be converted are read by clang
+   for (const auto &item : state->includeFiles) {
+      ClangSourceFile source = loadSourceFile(item);
+
+      if (source.contents) {
+         addUnsavedFile(files, item, source.contents);
+      } else {
+         files.fileLength.insert(item, source.length);
+      }
+   }
+
+   // file names are only stable once all files are added
+   for (int i = 0; i < files.ufs.size(); ++i) {
+      files.ufs[i].Filename = files.names[i].constData();
+   }
+}
+
+static void parseTranslationUnit(ClangTuState *state)
+{
+   std::vector<std::string> dbArgList;
+
+   if (! compilationDatabaseArguments(state->fileName, dbArgList)) {
+      state->pchName = precompiledHeader(state->fileName, state->detectedLang);
+   }
+
+   std::vector<std::string> argList = clangArguments(state->fileName, state->detectedLang, state->pchName);
+
+   // data structure, source filename (in argv), cmd line args, num of cmd line args
+   // pass include files, num of unsaved files, clang flag, trans unit (file name)
+
+   std::vector<const char *> argv;
+   for (auto &item : argList) {
+      argv.push_back(item.c_str());
+   }
+
+   int argc = argList.size();
+
+   // exclude PCH files, disable diagnostics
+   state->index = clang_createIndex(false, false);
+
+   // libClang - used to set up the tokens for comments
+   state->errorCode = clang_parseTranslationUnit2(state->index, 0, &argv[0], argc, state->files.ufs.data(), state->files.ufs.size(),
+                  CXTranslationUnit_DetailedPreprocessingRecord, &(state->tu) );
+
+   if (state->errorCode == CXError_ASTReadError && ! state->pchName.isEmpty()) {
+      // pch is out of date, a header it was built from changed
+      if (state->tu) {
+         clang_disposeTranslationUnit(state->tu);
+         state->tu = 0;
+      }
+
+      clang_disposeIndex(state->index);
+      state->index = 0;
+
+      state->pchName = precompiledHeader(state->fileName, state->detectedLang, true);
+      argList = clangArguments(state->fileName, state->detectedLang, state->pchName);
+
+      argv.clear();
+      for (auto &item : argList) {
+         argv.push_back(item.c_str());
+      }
+
+      argc = argList.size();
+
+      state->index     = clang_createIndex(false, false);
+      state->errorCode = clang_parseTranslationUnit2(state->index, 0, &argv[0], argc, state->files.ufs.data(), state->files.ufs.size(),
+                  CXTranslationUnit_DetailedPreprocessingRecord, &(state->tu) );
+   }
+}
+
+// run the libTooling frontend which creates the entries for the translation unit
+static void parseEntries(ClangTuState *state)
+{
+   std::vector<std::string> argList = clangArguments(state->fileName, state->detectedLang, state->pchName);
+
+   // strip out the fileName
+   argList.erase(argList.end() - 1);
+
+   state->entries       = parseWithTooling(state->fileName, *state->files.sources[0], argList, state->tuIndex);
+   state->entriesParsed = true;
+}
+
+// release a translation unit which was parsed but not used
+static void disposeTuState(ClangTuState *state)
+{
+   if (state->tu) {
+      clang_disposeTranslationUnit(state->tu);
+   }
+
+   if (state->index) {
+      clang_disposeIndex(state->index);
+   }
+
+   delete state;
+}
+
+// true if writeSources() links the token to the symbol it refers to
+static bool tokenNeedsUsr(CXTokenKind tokenKind, CXCursorKind cursorKind, const QString &text)
+{
+   switch (tokenKind) {
+      case CXToken_Keyword:
+         return text == "operator";
+
+      case CXToken_Literal:
+      case CXToken_Comment:
+         return false;
+
+      default:
+         switch (cursorKind) {
+            case CXCursor_PreprocessingDirective:
+            case CXCursor_MacroDefinition:
+            case CXCursor_InclusionDirective:
+            case CXCursor_MacroExpansion:
+               return false;
+
+            default:
+               return tokenKind == CXToken_Identifier || (tokenKind == CXToken_Punctuation &&
+                     (cursorKind == CXCursor_DeclRefExpr || cursorKind == CXCursor_MemberRefExpr ||
+                      cursorKind == CXCursor_CallExpr || cursorKind == CXCursor_ObjCMessageExpr));
+         }
+   }
+}
+
+// returns the USR of the symbol a token refers to
+static QString referencedUsr(CXCursor cursor)
+{
+   CXCursor c = cursor;
+   CXCursor r = clang_getCursorReferenced(c);
+
+   if (! clang_equalCursors(r, c)) {
+      // link to referenced location
+      c = r;
+   }
+
+   CXCursor t = clang_getSpecializedCursorTemplate(c);
+
+   if (! clang_Cursor_isNull(t) && ! clang_equalCursors(t, c)) {
+      // link to template
+      c = t;
+   }
+
+   return getCursorUSR(c);
+}
+
+// source is the buffer clang parsed for the file the tokens belong to
+static QSharedPointer<ClangTokenTable> createTokenTable(CXTranslationUnit tu, CXToken *tokens, CXCursor *cursors, uint numTokens,
+                  QSharedPointer<QByteArray> source)
+{
+   QSharedPointer<ClangTokenTable> table = QMakeShared<ClangTokenTable>();
+   QHash<QString, int> usrIndex;
+
+   table->source = source;
+   table->tokens.reserve(numTokens);
+
+   for (uint i = 0; i < numTokens; i++) {
+      ClangToken token;
+      uint endOffset;
+
+      CXSourceRange extent = clang_getTokenExtent(tu, tokens[i]);
+      clang_getSpellingLocation(clang_getRangeStart(extent), 0, &token.line, &token.column, &token.offset);
+      clang_getSpellingLocation(clang_getRangeEnd(extent), 0, 0, 0, &endOffset);
+
+      if (endOffset > (uint)source->size()) {
+         endOffset = source->size();
+      }
+
+      token.tokenKind  = clang_getTokenKind(tokens[i]);
+      token.cursorKind = clang_getCursorKind(cursors[i]);
+      token.length     = endOffset > token.offset ? endOffset - token.offset : 0;
+      token.usr        = -1;
+
+      if (tokenNeedsUsr(token.tokenKind, token.cursorKind, table->text(token))) {
+         QString usr = referencedUsr(cursors[i]);
+         auto iter   = usrIndex.find(usr);
+
+         if (iter == usrIndex.end()) {
+            iter = usrIndex.insert(usr, table->usrList.size());
+            table->usrList.append(usr);
+         }
+
+         token.usr = iter.value();
+      }
+
+      table->tokens.append(token);
+   }
+
+   return table;
+}
+
+// the main file was parsed after converting the comments, replace the comment tokens with the comments
+// of the original source, returns false if the code tokens do not match the original source
+static bool restoreSourceComments(ClangTokenTable &table, QSharedPointer<QByteArray> original)
+{
+   const QByteArray &source = *original;
+
+   QVector<int> lineStart;
+   lineStart.append(0);
+
+   for (int i = 0; i < source.size(); ++i) {
+      if (source[i] == '\n') {
+         lineStart.append(i + 1);
+      }
+   }
+
+   QVector<ClangToken> tokens;
+   tokens.reserve(table.tokens.size());
+
+   auto addComment = [&tokens, &lineStart, &source] (int from, int to) {
+      ClangToken token;
+
+      token.line       = std::upper_bound(lineStart.begin(), lineStart.end(), from) - lineStart.begin();
+      token.column     = from - lineStart[token.line - 1] + 1;
+      token.tokenKind  = CXToken_Comment;
+      token.cursorKind = CXCursor_InvalidCode;
+      token.offset     = from;
+      token.length     = to - from;
+      token.usr        = -1;
+
+      tokens.append(token);
+   };
+
+   // everything between two code tokens must be white space or a comment
+   auto scanGap = [&addComment, &source] (int from, int to) {
+      int i = from;
+
+      while (i < to) {
+         char c = source[i];
+
+         if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v') {
+            ++i;
+
+         } else if (c == '\\' && i + 1 < to && (source[i + 1] == '\n' || source[i + 1] == '\r')) {
+            // line continuation
+            ++i;
+
+         } else if (c == '/' && i + 1 < to && source[i + 1] == '*') {
+            int end = source.indexOf("*/", i + 2);
+
+            if (end == -1 || end + 2 > to) {
+               return false;
+            }
+
+            addComment(i, end + 2);
+            i = end + 2;
+
+         } else if (c == '/' && i + 1 < to && source[i + 1] == '/') {
+            int end = source.indexOf('\n', i);
+
+            if (end == -1 || end > to) {
+               end = to;
+            }
+
+            if (source[end - 1] == '\r') {
+               --end;
+            }
+
+            addComment(i, end);
+            i = end;
+
+         } else {
+            return false;
+         }
+      }
+
+      return true;
+   };
+
+   int pos = 0;
+
+   for (const auto &token : table.tokens) {
+
+      if (token.tokenKind == CXToken_Comment) {
+         continue;
+      }
+
+      if (token.line < 1 || token.line > (uint)lineStart.size()) {
+         return false;
+      }
+
+      int offset = lineStart[token.line - 1] + token.column - 1;
+      int length = token.length;
+
+      if (offset < pos || offset + length > source.size() ||
+            memcmp(source.constData() + offset, table.source->constData() + token.offset, length) != 0) {
+         return false;
+      }
+
+      if (! scanGap(pos, offset)) {
+         return false;
+      }
+
+      tokens.append(token);
+      tokens.last().offset = offset;
+
+      pos = offset + length;
+   }
+
+   if (! scanGap(pos, source.size())) {
+      return false;
+   }
+
+   table.tokens = std::move(tokens);
+   table.source = original;
+
+   return true;
+}
+
+// contents of a file as passed to clang when the file is parsed without a buffer
+static QByteArray sourceFileContents(const QString &fileName)
+{
+   ClangSourceFile source = loadSourceFile(fileName);
+
+   if (source.contents) {
+      return *source.contents;
+   }
+
+   QFile file(fileName);
+
+   if (! file.open(QIODevice::ReadOnly)) {
+      return QByteArray();
+   }
+
+   return file.readAll();
+}
+
+// contents clang parsed for fileName
+static QSharedPointer<QByteArray> parsedFileContents(const ClangSourceFiles &files, const QString &fileName)
+{
+   QByteArray name = fileName.toUtf8();
+
+   for (int i = 0; i < files.names.size(); ++i) {
+      if (files.names[i] == name) {
+         return files.sources[i];
+      }
+   }
+
+   return QMakeShared<QByteArray>(sourceFileContents(fileName));
+}
+
+// save the current tokens of fileName so writeSources() does not need to parse the translation unit again
+static void saveTokenTable(ClangParser::Private *p, const QString &fileName, bool isMainFile)
+{
+   QSharedPointer<ClangTokenTable> table = createTokenTable(p->tu, p->tokens, p->cursors, p->numTokens,
+                  parsedFileContents(p->files, fileName));
+
+   if (isMainFile && ! restoreSourceComments(*table, QMakeShared<QByteArray>(sourceFileContents(fileName)))) {
+      // source will be parsed again when it is written
+      return;
+   }
+
+   p->tokenTables.insert(fileName, table);
+}
+
+// remove the files which were not included by a translation unit
+static void filterIncludedFiles(QStringList &files)
+{
+   QStringList resultIncludes;
+
+   for (auto item : files) {
+      if (s_includedFiles.contains(item)) {
+         resultIncludes.append(item);
+      }
+   }
+
+   // replace the original list
+   files = resultIncludes;
+}
+
+ClangTuQueue::ClangTuQueue(const QVector<ClangTuState *> &list, int maxReadAhead)
+   : m_states(list), m_parsed(list.size(), false), m_nextIndex(0), m_consumed(0), m_loaded(0),
+     m_maxReadAhead(maxReadAhead), m_stop(false)
+{
+}
+
+ClangTuQueue::~ClangTuQueue()
+{
+   for (auto state : m_states) {
+      if (state != nullptr) {
+         disposeTuState(state);
+      }
+   }
+}
+
+ClangTuState *ClangTuQueue::dequeue()
 {
-   QSharedPointer<Definition> d;
+   QMutexLocker locker(&m_mutex);
 
-   if (fd) {
-      d = fd->getSourceDefinition(line);
+   while (! m_stop && m_nextIndex < m_states.size() && (m_nextIndex >= m_loaded || m_nextIndex - m_consumed >= m_maxReadAhead)) {
+      // wait for the main thread to load the sources, limit the number of translation units kept in memory
+      m_tuAvailable.wait(&m_mutex);
    }
 
-   if (d && d->isLinkable()) {
-      s_currentDefinition = d;
-      g_currentLine = line;
+   if (m_stop || m_nextIndex >= m_states.size()) {
+      return nullptr;
+   }
 
-      QSharedPointer<MemberDef> md = fd->getSourceMember(line);
+   return m_states[m_nextIndex++];
+}
 
-      if (md && md->isLinkable()) {
-         // link to member
+void ClangTuQueue::setParsed(ClangTuState *state)
+{
+   QMutexLocker locker(&m_mutex);
 
-         if (s_currentMemberDef != md) {
-            // new member, start search for body
+   int index = m_states.indexOf(state);
+   m_parsed[index] = true;
 
-            g_searchForBody = true;
-            g_insideBody    = false;
-            g_bracketCount  = 0;
-         }
+   m_tuParsed.wakeAll();
+}
 
-         s_currentMemberDef = md;
-         ol.writeLineNumber(md->getReference(), md->getOutputFileBase(), md->anchor(), line);
+ClangTuState *ClangTuQueue::nextToLoad()
+{
+   QMutexLocker locker(&m_mutex);
 
-      } else {
-         // link to compound
-         s_currentMemberDef = QSharedPointer<MemberDef>();
-         ol.writeLineNumber(d->getReference(), d->getOutputFileBase(), d->anchor(), line);
-      }
+   // translation units before m_nextIndex were either taken by a worker or released by take()
+   m_loaded = qMax(m_loaded, m_nextIndex);
 
-   } else {
-      // no link
-      ol.writeLineNumber(0, 0, 0, line);
+   if (m_loaded >= m_states.size() || m_loaded - m_consumed >= m_maxReadAhead) {
+      return nullptr;
    }
 
-   // set search page target
-   if (Doxy_Globals::searchIndexBase != nullptr) {
-      QString lineAnchor = QString("l%1").arg(line, 5, 10, QChar('0'));
-      ol.setCurrentDoc(fd, lineAnchor, true);
-   }
+   return m_states[m_loaded];
 }
 
-static void writeMultiLineCodeLink(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint &line, uint &column,
-                  QSharedPointer<Definition> d, const QString &text)
+void ClangTuQueue::setLoaded()
 {
-   static bool sourceTooltips = Config::getBool("source-tooltips");
-   TooltipManager::instance()->addTooltip(d);
+   QMutexLocker locker(&m_mutex);
 
-   QString ref    = d->getReference();
-   QString file   = d->getOutputFileBase();
-   QString anchor = d->anchor();
+   ++m_loaded;
+   m_tuAvailable.wakeAll();
+}
 
-   QString tooltip;
+bool ClangTuQueue::takeBuffer(const QString &fileName, QString &buffer)
+{
+   QMutexLocker locker(&m_mutex);
 
-   if (! sourceTooltips) {
-      // fall back to simple "title" tooltips
-      tooltip = d->briefDescriptionAsTooltip();
+   for (int i = m_consumed; i < m_loaded; ++i) {
+      if (m_states[i]->fileName == fileName) {
+         buffer = m_states[i]->buffer;
+         m_states[i]->buffer = QString();
+
+         return ! buffer.isEmpty();
+      }
    }
 
-   QString tmp;
+   return false;
+}
 
-   for (auto c : text) {
+ClangTuState *ClangTuQueue::take(const QString &fileName)
+{
+   QMutexLocker locker(&m_mutex);
 
-      if (c == '\n') {
-         line++;
+   int index = -1;
 
-         ol.writeCodeLink(ref, file, anchor, tmp, tooltip);
-         ol.endCodeLine();
+   for (int i = m_consumed; i < m_states.size(); ++i) {
+      if (m_states[i]->fileName == fileName) {
+         index = i;
+         break;
+      }
+   }
 
-         ol.startCodeLine(true);
-         writeLineNumber(ol, fd, line);
+   if (index == -1) {
+      // not scheduled, parsed by the caller
+      return nullptr;
+   }
 
-         tmp = "";
+   for (int i = m_consumed; i < index; ++i) {
+      // translation units which were skipped are no longer needed, release them first
+      // so the workers are not held back by the read ahead limit
 
-      } else {
-         column++;
-         tmp += c;
+      if (i < m_nextIndex) {
+         while (! m_parsed[i]) {
+            m_tuParsed.wait(&m_mutex);
+         }
 
+      } else {
+         // not started by a worker
+         m_nextIndex = i + 1;
       }
+
+      disposeTuState(m_states[i]);
+      m_states[i] = nullptr;
+
+      m_consumed = i + 1;
+      m_tuAvailable.wakeAll();
    }
 
-   if (! tmp.isEmpty() )  {
-      ol.writeCodeLink(ref, file, anchor, tmp, tooltip);
+   ClangTuState *retval = nullptr;
+
+   if (index < m_nextIndex) {
+      while (! m_parsed[index]) {
+         // wait until a worker thread has parsed this translation unit
+         m_tuParsed.wait(&m_mutex);
+      }
+
+      retval = m_states[index];
+
+   } else {
+      // not started by a worker, parsed by the caller
+      disposeTuState(m_states[index]);
+      m_nextIndex = index + 1;
    }
+
+   m_states[index] = nullptr;
+
+   m_consumed = index + 1;
+   m_tuAvailable.wakeAll();
+
+   return retval;
 }
 
-// call back, called for each include in a translation unit
-static void inclusionVisitor(CXFile file, CXSourceLocation *, uint, CXClientData clientData)
+void ClangTuQueue::stop()
 {
-   s_includedFiles.insert(getFileName(file));
+   QMutexLocker locker(&m_mutex);
+
+   m_stop = true;
+   m_tuAvailable.wakeAll();
 }
 
-static bool documentKind(CXCursor cursor)
+void ClangWorkerThread::run()
 {
-   CXCursorKind kind = clang_getCursorKind(cursor);
+   ClangTuState *state;
 
-   if (kind == CXCursor_FunctionDecl       ||
-       kind == CXCursor_FunctionTemplate   ||
-       kind == CXCursor_ClassDecl          ||
-       kind == CXCursor_ClassTemplate      ||
-       kind == CXCursor_StructDecl         ||
-       kind == CXCursor_Constructor        ||
-       kind == CXCursor_Destructor         ||
-       kind == CXCursor_ConversionFunction ||
-       kind == CXCursor_UnionDecl          ||
-       kind == CXCursor_EnumDecl           ||
-       kind == CXCursor_EnumConstantDecl   ||
-       kind == CXCursor_FieldDecl          ||
-       kind == CXCursor_ParmDecl           ||
-       kind == CXCursor_VarDecl            ||
-       kind == CXCursor_CXXMethod          ||
-       kind == CXCursor_TypedefDecl        ||
-       kind == CXCursor_TypeAliasDecl      ||
-       kind == CXCursor_UnexposedDecl      ||
-       kind == CXCursor_MacroDefinition    ||
-       kind == CXCursor_Namespace    )  {
+   while ((state = m_queue->dequeue()) != nullptr) {
+      // sources were loaded by the main thread
+      parseTranslationUnit(state);
 
-      return true;
-   }
+      if (state->tu && state->errorCode == CXError_Success) {
+         parseEntries(state);
+      }
 
-   return false;
+      m_queue->setParsed(state);
+   }
 }
 
-// ** entry point
-void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStringList &includeFiles, QSharedPointer<Entry> root)
+// read and convert the sources of the queued translation units, comment conversion is not thread safe
+static void loadQueuedSources(ClangTuQueue *queue)
 {
-   static QStringList const includePath      = Config::getList("include-path");
-   static QStringList const clangFlags       = Config::getList("clang-flags");
-   static QStringList const preDefinedMacros = Config::getList("predefined-macros");
-
-   static std::vector<std::string> clangCmdArgs;
-   std::vector<std::string> argList;
+   ClangTuState *state;
 
-   if (clangCmdArgs.empty()) {
+   while ((state = queue->nextToLoad()) != nullptr) {
+      // read and convert the source the same way Doxy_Work::parseFile does
+      QString fileContents = readInputFile(state->fileName);
 
-      // add include paths for input files
-      for (auto &item : Doxy_Globals::inputPaths) {
-         std::string inc = std::string("-I") + item.toUtf8().constData();
-         argList.push_back(std::move(inc));
+      if (! fileContents.endsWith("\n")) {
+         fileContents += '\n';
       }
 
-      // add external include paths
-      for (auto &item : includePath) {
-         std::string inc = std::string("-I") + item.toUtf8().constData();
-         argList.push_back(std::move(inc));
-      }
+      state->buffer = convertCppComments(fileContents, state->fileName);
 
-      // add predefinded macros
-      for (const auto &item : preDefinedMacros) {
-         std::string macro = std::string("-D") + item.toUtf8().constData();
-         argList.push_back(std::move(macro));
-      }
+      loadUnsavedFiles(state, state->buffer);
+      queue->setLoaded();
+   }
+}
 
-      // user specified flags
-      for (auto &item : clangFlags) {
-         argList.push_back(item.toUtf8().constData());
-      }
+void ClangParser::startWorkers(const QVector<QPair<QString, QStringList>> &files, int numThreads)
+{
+   if (numThreads <= 1 || files.size() < 2 || p->queue != nullptr) {
+      return;
+   }
 
-      argList.push_back("-ferror-limit=0");
-      argList.push_back("-x");
+   QVector<ClangTuState *> list;
+   ClangParser::Private::DetectedLang lang = p->detectedLang;
 
-      // save for the next pass
-      clangCmdArgs = argList;
+   for (const auto &item : files) {
+      ClangTuState *state = new ClangTuState;
 
-   } else {
-      // just copy the first x args since they do not change
-      argList = clangCmdArgs;
+      // language detection depends on the previous translation unit
+      lang = detectLanguage(item.first, lang);
+
+      state->fileName     = item.first;
+      state->includeFiles = item.second;
+      state->detectedLang = lang;
+      state->tuIndex      = p->tuCount + list.size();
 
+      list.append(state);
    }
 
-   // if the file is an .h file it can contain C, C++, or Objective C  (review)
-   // detection will fail if we pass .h files containing ObjC code and no source
+   p->queue = new ClangTuQueue(list, 2 * numThreads);
 
-   SrcLangExt lang = getLanguageFromFileName(fileName);
+   for (int i = 0; i < numThreads; i++) {
+      ClangWorkerThread *thread = new ClangWorkerThread(p->queue);
+      thread->start();
 
-   if (lang == SrcLangExt_ObjC || p->detectedLang != ClangParser::Private::Detected_Cpp) {
-      QFileInfo fi(fileName);
-      QString ext = fi.suffix().toLower();
+      if (thread->isRunning()) {
+         p->workers.append(thread);
+      } else {
+         // no more threads available
+         delete thread;
+      }
+   }
 
-      if (p->detectedLang == ClangParser::Private::Detected_Cpp &&
-            (ext == "cpp" || ext == "cxx" || ext == "cc" || ext == "c")) {
+   loadQueuedSources(p->queue);
+}
 
-         // fall back to C/C++ once we see an extension that indicates C++
-         p->detectedLang = ClangParser::Private::Detected_Cpp;
+bool ClangParser::takeQueuedSource(const QString &fileName, QString &buffer)
+{
+   if (p->queue == nullptr) {
+      return false;
+   }
 
-      } else if (ext == "mm") {
-         // switch to Objective C++
-         p->detectedLang = ClangParser::Private::Detected_ObjCpp;
+   return p->queue->takeBuffer(fileName, buffer);
+}
 
-      } else if (ext == "m") {
-         // switch to Objective C
-         p->detectedLang = ClangParser::Private::Detected_ObjC;
-      }
+void ClangParser::stopWorkers()
+{
+   if (p->queue == nullptr) {
+      return;
    }
 
-   switch (p->detectedLang) {
-      case ClangParser::Private::Detected_Cpp:
-         argList.push_back("c++");
-         break;
-
-      case ClangParser::Private::Detected_ObjC:
-         argList.push_back("objective-c");
-         break;
+   p->queue->stop();
 
-      case ClangParser::Private::Detected_ObjCpp:
-         argList.push_back("objective-c++");
-         break;
+   for (auto thread : p->workers) {
+      thread->wait();
+      delete thread;
    }
 
-   argList.push_back(fileName.toUtf8().constData());
+   p->workers.clear();
 
-   // exclude PCH files, disable diagnostics
-   p->index    = clang_createIndex(false, false);
+   delete p->queue;
+   p->queue = nullptr;
+}
 
-   p->fileName = fileName;
-   p->curLine  = 1;
-   p->curToken = 0;
+// ** entry point
+void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStringList &includeFiles, QSharedPointer<Entry> root)
+{
+   static const bool sourceCode      = Config::getBool("source-code");
+   static const bool verbatimHeaders = Config::getBool("verbatim-headers");
 
-   // provide the input and their dependencies as files in memory
-   static bool filterSourceFiles = Config::getBool("filter-source-files");
+   ClangParser::Private::DetectedLang lang = detectLanguage(fileName, p->detectedLang);
+   ClangTuState *state = nullptr;
 
-   uint numUnsavedFiles = includeFiles.count() + 1;
+   if (root == nullptr && ! p->forceParse && p->tokenTables.contains(fileName)) {
+      // called from writeSource in fileDef, tokens were saved when the translation unit was parsed
+      p->detectedLang = lang;
 
-   p->numFiles = numUnsavedFiles;
-   p->sources  = new QByteArray[numUnsavedFiles];
-   p->ufs      = new CXUnsavedFile[numUnsavedFiles];
+      p->fileName = fileName;
+      p->curLine  = 1;
+      p->curToken = 0;
 
-   // load main file
+      p->currentTable    = p->tokenTables.value(fileName);
+      p->pendingFile     = fileName;
+      p->pendingIncludes = includeFiles;
 
-   if (fileBuffer.isEmpty()) {
-      p->sources[0]   = detab(fileToString(fileName, filterSourceFiles, true)).toUtf8();
-   } else  {
-      p->sources[0]   = fileBuffer.toUtf8();
+      // inclusions of this translation unit were added when it was parsed
+      filterIncludedFiles(includeFiles);
+
+      return;
    }
 
-   p->ufs[0].Filename = strdup(fileName.toUtf8().constData());
-   p->ufs[0].Contents = p->sources[0].constData();
-   p->ufs[0].Length   = p->sources[0].length();
+   if (p->queue != nullptr && root != nullptr) {
+      // translation unit may have been parsed by a worker thread
+      loadQueuedSources(p->queue);
+      state = p->queue->take(fileName);
+
+      // keep the workers busy while this translation unit is processed
+      loadQueuedSources(p->queue);
 
-   //
-   uint i = 1;
-   for (const auto &item : includeFiles) {
+      if (state != nullptr && (state->detectedLang != lang || state->includeFiles != includeFiles ||
+                  *state->files.sources[0] != fileBuffer.toUtf8())) {
 
-      p->fileMapping.insert(item, i);
+         // input differs from what the worker used
+         disposeTuState(state);
+         state = nullptr;
+      }
+   }
 
-      // load include files
-      p->sources[i]      = detab(fileToString(item, filterSourceFiles, true)).toUtf8();
-      p->ufs[i].Filename = strdup(item.toUtf8().constData());
-      p->ufs[i].Contents = p->sources[i].constData();
-      p->ufs[i].Length   = p->sources[i].length();
+   if (state == nullptr) {
+      state = new ClangTuState;
 
-      i++;
+      state->fileName     = fileName;
+      state->includeFiles = includeFiles;
+      state->detectedLang = lang;
+      state->tuIndex      = p->tuCount;
+
+      loadUnsavedFiles(state, fileBuffer);
+      parseTranslationUnit(state);
    }
 
-   // what is in argList ( check this one more time )
-   // data structure, source filename (in argv), cmd line args, num of cmd line args
-   // pass include files, num of unsaved files, clang flag, trans unit (file name)
+   if (root != nullptr) {
+      ++p->tuCount;
 
-   std::vector<const char *> argv;
-   for (auto &item : argList) {
-      argv.push_back(item.c_str());
+      if (! state->entriesParsed && state->tu && state->errorCode == CXError_Success) {
+         parseEntries(state);
+      }
    }
 
-   int argc = argList.size();
+   p->detectedLang = lang;
 
-   // libClang - used to set up the tokens for comments
-   CXErrorCode errorCode = clang_parseTranslationUnit2(p->index, 0, &argv[0], argc, p->ufs, numUnsavedFiles,
-                  CXTranslationUnit_DetailedPreprocessingRecord, &(p->tu) );
+   p->fileName = fileName;
+   p->curLine  = 1;
+   p->curToken = 0;
+
+   p->index       = state->index;
+   p->tu          = state->tu;
+   p->files       = std::move(state->files);
+
+   p->currentTable.reset();
+   p->captureTokens = root != nullptr && (sourceCode || verbatimHeaders || Doxy_Globals::parseSourcesNeeded);
+
+   CXErrorCode errorCode     = state->errorCode;
+   DoxyToolingResult entries = state->entries;
+
+   delete state;
 
    if (p->tu && errorCode == CXError_Success) {
       // filter out any includes not found by the clang parser
@@ -661,32 +1905,15 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
          // called from writeSouce in fileDef
 
       } else {
-         // libTooling - used to parse the source
-
-         // start adding to entry
-         s_current_root = root;
+         // libTooling - used to parse the source, add the entries it created
+         s_entryMap = entries.entryMap;
          s_entryMap.insert("TranslationUnit", root);
 
-         // strip out the fileName
-         argList.erase(argList.end() - 1);
-
-         // pass all arguments except the file name, which was just removed
-         clang::tooling::FixedCompilationDatabase options(".", argList);
-
-         const std::string tmpFName = fileName.toUtf8().constData();
-
-         // pass the main file to parse
-         std::vector<std::string> sourceList;
-         sourceList.push_back(tmpFName);
-
-         // create a new clang tooling instance
-         clang::tooling::ClangTool tool(options, sourceList);
-
-         // use the file in memory
-         tool.mapVirtualFile(tmpFName, p->sources[0].constData());
-
-         // run the clang tooling to create a new FrontendAction
-         int result = tool.run(clang::tooling::newFrontendActionFactory<DoxyFrontEnd>().get());
+         if (entries.root) {
+            for (auto &item : entries.root->children()) {
+               root->addSubEntry(item, root);
+            }
+         }
       }
 
       // create a source range for the file
@@ -694,7 +1921,7 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
       CXFile f = clang_getFile(p->tu, fileName.toUtf8().constData());
 
       CXSourceLocation fileBegin = clang_getLocationForOffset(p->tu, f, 0);
-      CXSourceLocation fileEnd   = clang_getLocationForOffset(p->tu, f, p->ufs[0].Length);
+      CXSourceLocation fileEnd   = clang_getLocationForOffset(p->tu, f, p->files.ufs[0].Length);
       CXSourceRange    fileRange = clang_getRange(fileBegin, fileEnd);
 
       // generate tokens for the tu
@@ -709,6 +1936,10 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
          return;
       }
 
+      if (p->captureTokens) {
+         saveTokenTable(p, fileName, true);
+      }
+
       static const bool javadoc_auto_brief = Config::getBool("javadoc-auto-brief");
       static const bool qt_auto_brief      = Config::getBool("qt-auto-brief");
 
@@ -937,25 +2168,42 @@ void ClangParser::finish()
 
       clang_disposeTokens(p->tu, p->tokens, p->numTokens);
       clang_disposeTranslationUnit(p->tu);
-      clang_disposeIndex(p->index);
 
-      p->fileMapping.clear();
       p->tokens    = 0;
       p->numTokens = 0;
       p->cursors   = 0;
    }
 
-   for (uint i = 0; i < p->numFiles; i++) {
-      free((void *)p->ufs[i].Filename);
+   if (p->index) {
+      clang_disposeIndex(p->index);
+      p->index = 0;
+   }
+
+   p->files = ClangSourceFiles();
+   p->tu    = 0;
+
+   p->currentTable.reset();
+   p->pendingFile.clear();
+   p->pendingIncludes.clear();
+   p->captureTokens = false;
+}
+
+// parse the translation unit which was skipped by start() since the main file had saved tokens
+void ClangParser::parsePending()
+{
+   if (p->tu || p->pendingFile.isEmpty()) {
+      return;
    }
 
-   delete[] p->ufs;
-   delete[] p->sources;
+   QString fileName         = p->pendingFile;
+   QStringList includeFiles = p->pendingIncludes;
 
-   p->ufs       = 0;
-   p->sources   = 0;
-   p->numFiles  = 0;
-   p->tu        = 0;
+   p->pendingFile.clear();
+   p->pendingIncludes.clear();
+
+   p->forceParse = true;
+   start(fileName, QString(), includeFiles, QSharedPointer<Entry>());
+   p->forceParse = false;
 }
 
 static void handleCommentBlock(const QString &comment, bool brief, const QString &fileName, QSharedPointer<Entry> current)
@@ -1033,16 +2281,7 @@ void ClangParser::determineInputFiles(QStringList &files)
    clang_getInclusions(p->tu, inclusionVisitor, nullptr);
 
    // create a new filtered file list
-   QStringList resultIncludes;
-
-   for (auto item : files) {
-      if (s_includedFiles.contains(item)) {
-         resultIncludes.append(item);
-      }
-   }
-
-   // replace the original list
-   files = resultIncludes;
+   filterIncludedFiles(files);
 }
 
 QString ClangParser::lookup(uint line, const QString &symbol)
@@ -1194,30 +2433,12 @@ void ClangParser::linkMacro(CodeOutputInterface &ol, QSharedPointer<FileDef> fd,
 
 
 void ClangParser::linkIdentifier(CodeOutputInterface &ol, QSharedPointer<FileDef> fd,
-                                 uint &line, uint &column, const QString &text, int tokenIndex)
+                                 uint &line, uint &column, const QString &text, const QString &usr)
 {
-   CXCursor c = p->cursors[tokenIndex];
-   CXCursor r = clang_getCursorReferenced(c);
-
-   if (! clang_equalCursors(r, c)) {
-      // link to referenced location
-      c = r;
-   }
-
-   CXCursor t = clang_getSpecializedCursorTemplate(c);
-
-   if (! clang_Cursor_isNull(t) && !clang_equalCursors(t, c)) {
-      // link to template
-      c = t;
-   }
-
-   CXString usr = clang_getCursorUSR(c);
-   const char *usrStr = clang_getCString(usr);
-
    QSharedPointer<Definition> d;
 
-   if (usrStr) {
-      d = Doxy_Globals::clangUsrMap.value(usrStr);
+   if (! usr.isEmpty()) {
+      d = Doxy_Globals::clangUsrMap.value(usr);
    }
 
    if (d && d->isLinkable()) {
@@ -1233,12 +2454,20 @@ void ClangParser::linkIdentifier(CodeOutputInterface &ol, QSharedPointer<FileDef
    } else {
       codifyLines(ol, fd, text, line, column, "");
    }
-
-   clang_disposeString(usr);
 }
 
 void ClangParser::switchToFile(const QString &fileName)
 {
+   p->currentTable.reset();
+
+   if (! p->captureTokens && p->tokenTables.contains(fileName)) {
+      // tokens were saved when the translation unit was parsed
+      p->currentTable = p->tokenTables.value(fileName);
+      return;
+   }
+
+   parsePending();
+
    if (p->tu) {
       delete[] p->cursors;
 
@@ -1251,13 +2480,12 @@ void ClangParser::switchToFile(const QString &fileName)
       QFileInfo fi(fileName);
       CXFile f = clang_getFile(p->tu, fileName.toUtf8().constData());
 
-      uint pIndex = p->fileMapping.value(fileName);
-
-      if (pIndex < p->numFiles) {
-         uint i = pIndex;
+      if (! p->files.ufs.isEmpty()) {
+         // unknown files use the length of the main file
+         uint length = p->files.fileLength.value(fileName, p->files.ufs[0].Length);
 
          CXSourceLocation fileBegin = clang_getLocationForOffset(p->tu, f, 0);
-         CXSourceLocation fileEnd   = clang_getLocationForOffset(p->tu, f, p->ufs[i].Length);
+         CXSourceLocation fileEnd   = clang_getLocationForOffset(p->tu, f, length);
          CXSourceRange    fileRange = clang_getRange(fileBegin, fileEnd);
 
          clang_tokenize(p->tu, fileRange, &p->tokens, &p->numTokens);
@@ -1268,6 +2496,10 @@ void ClangParser::switchToFile(const QString &fileName)
          p->curLine  = 1;
          p->curToken = 0;
 
+         if (p->captureTokens) {
+            saveTokenTable(p, fileName, false);
+         }
+
       } else {
          err("Clang failed to find input file %s\n", csPrintable(fileName));
 
@@ -1279,6 +2511,19 @@ void ClangParser::writeSources(CodeOutputInterface &ol, QSharedPointer<FileDef>
 {
    static const bool stripCodeComments = Config::getBool("strip-code-comments");
 
+   QSharedPointer<ClangTokenTable> table = p->currentTable;
+
+   if (table) {
+      // saved tokens are only written once
+      p->tokenTables.remove(fd->getFilePath());
+      p->currentTable.reset();
+
+   } else {
+      parsePending();
+      table = createTokenTable(p->tu, p->tokens, p->cursors, p->numTokens, parsedFileContents(p->files, fd->getFilePath()));
+
+   }
+
    TooltipManager::instance()->clearTooltips();
 
    // set global parser state
@@ -1298,13 +2543,9 @@ void ClangParser::writeSources(CodeOutputInterface &ol, QSharedPointer<FileDef>
    ol.startCodeLine(true);
    writeLineNumber(ol, fd, line);
 
-   for (uint i = 0; i < p->numTokens; i++) {
-      CXSourceLocation start = clang_getTokenLocation(p->tu, p->tokens[i]);
-
-      uint t_line;
-      uint t_col;
-
-      clang_getSpellingLocation(start, 0, &t_line, &t_col, 0);
+   for (const auto &token : table->tokens) {
+      uint t_line = token.line;
+      uint t_col  = token.column;
 
       if (t_line > line) {
          column = 1;
@@ -1323,15 +2564,16 @@ void ClangParser::writeSources(CodeOutputInterface &ol, QSharedPointer<FileDef>
          column++;
       }
 
-      QString text = getTokenSpelling(p->tu, p->tokens[i]);
+      const QString text  = table->text(token);
+      const QString &usr  = token.usr >= 0 ? table->usrList[token.usr] : QString();
 
-      CXCursorKind cursorKind  = clang_getCursorKind(p->cursors[i]);
-      CXTokenKind tokenKind    = clang_getTokenKind(p->tokens[i]);
+      CXCursorKind cursorKind = token.cursorKind;
+      CXTokenKind tokenKind   = token.tokenKind;
 
       switch (tokenKind) {
          case CXToken_Keyword:
             if (text == "operator") {
-               linkIdentifier(ol, fd, line, column, text, i);
+               linkIdentifier(ol, fd, line, column, text, usr);
 
             } else {
                QString temp;
@@ -1418,7 +2660,7 @@ void ClangParser::writeSources(CodeOutputInterface &ol, QSharedPointer<FileDef>
                          (cursorKind == CXCursor_DeclRefExpr || cursorKind == CXCursor_MemberRefExpr ||
                           cursorKind == CXCursor_CallExpr || cursorKind == CXCursor_ObjCMessageExpr)) ) {
 
-                     linkIdentifier(ol, fd, line, column, text, i);
+                     linkIdentifier(ol, fd, line, column, text, usr);
 
                      if (Doxy_Globals::searchIndexBase != nullptr) {
                         ol.addWord(text, false);
@@ -18,7 +18,9 @@
 #ifndef PARSE_CLANG_H
 #define PARSE_CLANG_H
 
+#include <QPair>
 #include <QStringList>
+#include <QVector>
 
 #include <clang-c/Index.h>
 #include <clang-c/Documentation.h>
@@ -43,10 +45,21 @@ class ClangParser
    // clean up, free resources used in parsing   
    void finish();
 
+   // parse the translation units of files on worker threads before start() is called for them
+   // files - source file name and its include files, in the order start() will be called
+   void startWorkers(const QVector<QPair<QString, QStringList>> &files, int numThreads);
+
+   // wait for the worker threads, release translation units which were not used
+   void stopWorkers();
+
+   // returns true and sets buffer to the converted source of fileName if it was read when the
+   // translation unit was queued for the worker threads
+   bool takeQueuedSource(const QString &fileName, QString &buffer);
+
    // looks for a symbol which should be found at line, returns a clang unique ref to the symbol    
    QString lookup(uint line, const QString &symbol);
 
-   // writes the syntax highlighted source code for a file
+   // writes the syntax highlighted source code for a file, uses the tokens saved while parsing if available
    // ol- output generator list to write to, fd- file to write sources for    
    void writeSources(CodeOutputInterface &ol, QSharedPointer<FileDef> fd);
 
@@ -60,7 +73,7 @@ class ClangParser
    Private *p;
 
    void linkIdentifier(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint &line, 
-                  uint &column, const QString &text, int tokenIndex);
+                  uint &column, const QString &text, const QString &usr);
 
    void linkMacro(CodeOutputInterface &ol, QSharedPointer<FileDef> fd, uint &line, 
                   uint &column, const QString &text);
@@ -69,6 +82,8 @@ class ClangParser
                   uint &column, const QString &text);
 
    void determineInputFiles(QStringList &includeFiles);  
+
+   void parsePending();
 };
 
 #endif
@@ -20,9 +20,13 @@
 #include <config.h>
 #include <util.h>
 
-static QMap<QString, clang::DeclContext *>  s_parentNodeMap;
-static QMultiMap<QString, QSharedPointer<Entry>> s_orphanMap;
-static int anonNSCount  = 0;
+// state of the translation unit parsed by the current thread
+static thread_local QSharedPointer<Entry> s_current_root;
+static thread_local QMap<QString, QSharedPointer<Entry>> s_entryMap;
+
+static thread_local QMap<QString, clang::DeclContext *>  s_parentNodeMap;
+static thread_local QMultiMap<QString, QSharedPointer<Entry>> s_orphanMap;
+static thread_local int anonNSCount  = 0;
 
 static Protection getAccessSpecifier(const clang::Decl *node)
 {
@@ -1177,9 +1181,6 @@ class DoxyASTConsumer : public clang::ASTConsumer {
 
             }
          }
-
-         // increment for each TU
-         anonNSCount++;
       }
 
    private:
@@ -1189,3 +1190,44 @@ class DoxyASTConsumer : public clang::ASTConsumer {
 std::unique_ptr<clang::ASTConsumer> DoxyFrontEnd::CreateASTConsumer(clang::CompilerInstance &compiler, llvm::StringRef file) {
    return std::unique_ptr<clang::ASTConsumer>(new DoxyASTConsumer(&compiler.getASTContext()));
 }
+
+DoxyToolingResult parseWithTooling(const QString &fileName, const QByteArray &contents,
+                  const std::vector<std::string> &argList, int tuIndex)
+{
+   DoxyToolingResult result;
+   result.root = QMakeShared<Entry>();
+
+   // start adding to entry
+   s_current_root = result.root;
+   s_entryMap.insert("TranslationUnit", result.root);
+
+   anonNSCount = tuIndex;
+
+   // relative paths in argList were resolved, all threads use the same working directory
+   clang::tooling::FixedCompilationDatabase options(".", argList);
+
+   const std::string tmpFName = fileName.toUtf8().constData();
+
+   // pass the main file to parse
+   std::vector<std::string> sourceList;
+   sourceList.push_back(tmpFName);
+
+   // create a new clang tooling instance
+   clang::tooling::ClangTool tool(options, sourceList);
+
+   // use the file in memory
+   tool.mapVirtualFile(tmpFName, contents.constData());
+
+   // run the clang tooling to create a new FrontendAction
+   tool.run(clang::tooling::newFrontendActionFactory<DoxyFrontEnd>().get());
+
+   result.entryMap = s_entryMap;
+
+   // entries of one translation unit are not linked to another one
+   s_current_root.reset();
+   s_entryMap.clear();
+   s_parentNodeMap.clear();
+   s_orphanMap.clear();
+
+   return result;
+}
@@ -29,8 +29,20 @@
 #include <clang/Index/USRGeneration.h>
 #include <clang/Tooling/Tooling.h>
 
-extern QSharedPointer<Entry> s_current_root;
-extern QMap<QString, QSharedPointer<Entry>> s_entryMap;
+/** @brief Entries created by the libTooling frontend for one translation unit
+ */
+struct DoxyToolingResult
+{
+   QSharedPointer<Entry> root;
+
+   // entries by clang USR, used to add the comments found by libclang
+   QMap<QString, QSharedPointer<Entry>> entryMap;
+};
+
+// runs the frontend on fileName, argList are the compiler arguments without the file name
+// tuIndex is the position of the translation unit, may be called from several threads at once
+DoxyToolingResult parseWithTooling(const QString &fileName, const QByteArray &contents,
+                  const std::vector<std::string> &argList, int tuIndex);
 
 class DoxyFrontEnd : public clang::ASTFrontendAction
 {
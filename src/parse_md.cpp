@@ -2130,6 +2130,7 @@ void writeOneLineHeaderOrRuler(QString &out, const QString &data, int size)
          out += "\n";
 
          QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(id);
+         Doxy_Globals::parseSideEffects++;
 
          if (si) {
             if (si->lineNr != -1) {
@@ -2547,6 +2548,7 @@ static QString processBlocks(const QString &str, int indent)
                   out += "\n\n";
 
                   QSharedPointer<SectionInfo> si (Doxy_Globals::sectionDict.find(id));
+                  Doxy_Globals::parseSideEffects++;
 
                   if (si) {
                      if (si->lineNr != -1) {
@@ -23,5 +23,6 @@ void removePreProcessor();
 void addSearchDir(const QString &dir);
 QString preprocessFile(const QString &fileName, const QString &input);
 void preFreeScanner();
+void preAddStatistics();
 
 #endif
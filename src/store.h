@@ -35,6 +35,25 @@ class StorageIntf
 
    /*! Write \a size bytes from \a buf into the store. */
    virtual int write(const char *buf, uint size) = 0;
+
+   /*! Returns a pointer to the next \a size bytes of the store and skips them.
+    *  Returns a nullptr if the store can not be accessed directly, read() must be used.
+    */
+   virtual const char *readDirect(uint) {
+      return nullptr;
+   }
+
+   /*! Returns the index of \a str in the string table of the store, used to write a
+    *  repeated string once. Returns -1 if the string must be written in full.
+    */
+   virtual int internString(const QString &) {
+      return -1;
+   }
+
+   /*! Returns the string at \a index in the string table of the store. */
+   virtual QString sharedString(uint) {
+      return QString();
+   }
 };
 
 /*! @brief The Store is a file based memory manager.
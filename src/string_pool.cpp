@@ -0,0 +1,64 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include <string_pool.h>
+
+#include <doxy_globals.h>
+
+// longer strings are returned unchanged
+static const int MAX_INTERN_LENGTH = 256;
+
+static QMutex        s_poolMutex;
+static QSet<QString> s_pool;
+
+static long s_lookups = 0;
+static long s_shared  = 0;
+
+QString StringPool::intern(const QString &str)
+{
+   if (str.isEmpty() || str.length() > MAX_INTERN_LENGTH) {
+      return str;
+   }
+
+   QMutexLocker lock(&s_poolMutex);
+
+   ++s_lookups;
+
+   auto iter = s_pool.constFind(str);
+
+   if (iter != s_pool.constEnd()) {
+      ++s_shared;
+      return *iter;
+   }
+
+   s_pool.insert(str);
+
+   return str;
+}
+
+void StringPool::addStatistics()
+{
+   QMutexLocker lock(&s_poolMutex);
+
+   Doxy_Globals::infoLog_Stat.addCounter("string pool lookups",           s_lookups);
+   Doxy_Globals::infoLog_Stat.addCounter("string pool lookups shared",    s_shared);
+   Doxy_Globals::infoLog_Stat.addCounter("string pool distinct strings",  s_pool.size());
+}
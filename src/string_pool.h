@@ -0,0 +1,39 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <QString>
+
+/** \brief Pool of the names, scopes, types and file names used by the definitions
+ *
+ *  QString is implicitly shared, so every string returned by intern() which is equal to an
+ *  earlier one refers to the same buffer instead of keeping a private copy. Comparing two
+ *  interned strings only compares the length and the buffer address.
+ *
+ *  Long strings like documentation are not added to the pool since they are rarely duplicated.
+ */
+class StringPool
+{
+ public:
+   static QString intern(const QString &str);
+
+   static void addStatistics();
+};
+
+#endif
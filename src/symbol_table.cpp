@@ -0,0 +1,55 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <symbol_table.h>
+
+void SymbolTable::insert(const QString &name, Definition *def)
+{
+   m_symbols[name].m_symbols.append(Symbol(def));
+}
+
+void SymbolTable::remove(const QString &name, Definition *def)
+{
+   auto iter = m_symbols.find(name);
+
+   if (iter == m_symbols.end()) {
+      return;
+   }
+
+   QVector<Symbol> &list = iter.value().m_symbols;
+
+   for (int i = list.size() - 1; i >= 0; --i) {
+      if (list[i].def == def) {
+         list.remove(i);
+      }
+   }
+
+   if (list.isEmpty()) {
+      m_symbols.erase(iter);
+   }
+}
+
+const SymbolList *SymbolTable::find(const QString &name) const
+{
+   auto iter = m_symbols.constFind(name);
+
+   if (iter == m_symbols.constEnd()) {
+      return nullptr;
+   }
+
+   return &iter.value();
+}
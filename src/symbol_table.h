@@ -0,0 +1,109 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2017 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <definition.h>
+
+/** \brief One definition registered under its unqualified name */
+struct Symbol {
+   Symbol()
+      : def(nullptr), type(-1)
+   {}
+
+   explicit Symbol(Definition *d)
+      : def(d), type(-1)
+   {}
+
+   // the type is looked up on first use since the symbol is added from the Definition constructor
+   Definition::DefType definitionType() const {
+      if (type == -1) {
+         type = def->definitionType();
+      }
+
+      return static_cast<Definition::DefType>(type);
+   }
+
+   Definition *def;
+   mutable int type;
+};
+
+/** \brief Definitions which share one unqualified name
+ *
+ *  Iterating returns the definitions starting with the one added last.
+ */
+class SymbolList
+{
+ public:
+   using const_iterator = QVector<Symbol>::const_reverse_iterator;
+
+   const_iterator begin() const {
+      return m_symbols.crbegin();
+   }
+
+   const_iterator end() const {
+      return m_symbols.crend();
+   }
+
+   int count() const {
+      return m_symbols.size();
+   }
+
+   bool isEmpty() const {
+      return m_symbols.isEmpty();
+   }
+
+ private:
+   QVector<Symbol> m_symbols;
+
+   friend class SymbolTable;
+};
+
+/** \brief Table of all definitions indexed by their unqualified name
+ *
+ *  The definitions for one name are kept in a single array together with their type, so a search
+ *  which is only interested in members can skip the other candidates without calling back into
+ *  the definition. Since the table is filled from the Definition constructor it holds raw pointers
+ *  and a definition removes itself from the destructor.
+ */
+class SymbolTable
+{
+ public:
+   void insert(const QString &name, Definition *def);
+   void remove(const QString &name, Definition *def);
+
+   bool contains(const QString &name) const {
+      return m_symbols.contains(name);
+   }
+
+   // returns the definitions for name, or a null pointer if there are none
+   const SymbolList *find(const QString &name) const;
+
+   const QHash<QString, SymbolList> &symbols() const {
+      return m_symbols;
+   }
+
+ private:
+   QHash<QString, SymbolList> m_symbols;
+};
+
+#endif
@@ -20,9 +20,16 @@
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProcess>
+#include <QReadLocker>
+#include <QReadWriteLock>
 #include <QRegExp>
 #include <QTextCodec>
+#include <QWriteLocker>
+
+#include <atomic>
 
 #include <stdlib.h>
 #include <errno.h>
@@ -40,6 +47,7 @@
 #include <image.h>
 #include <language.h>
 #include <message.h>
+#include <string_pool.h>
 #include <textdocvisitor.h>
 
 struct FindFileCacheElem {
@@ -68,6 +76,9 @@ static QHash<QString, QSharedPointer<Definition>>  s_visitedNamespaces;
 
 static QSet<QString> s_aliasesProcessed;
 
+// lookups of getResolvedClassRec() which are being computed by this thread
+static thread_local QSet<LookupKey> s_lookupsInProgress;
+
 static QCache<QPair<const FileNameDict *, QString>, FindFileCacheElem> s_findFileDefCache;
 
 // forward declaration
@@ -676,9 +687,9 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
       return result;
    }
 
-   auto iter = Doxy_Globals::glossary().find(phraseName);
+   const SymbolList *symbols = Doxy_Globals::glossary().find(phraseName);
 
-   if (iter == Doxy_Globals::glossary().end()) {
+   if (symbols == nullptr) {
       // could not find a matching def
       return "";
    }
@@ -687,12 +698,12 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
 
    QSharedPointer<MemberDef> bestMatch;
 
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == phraseName)  {
+   for (const auto &symbol : *symbols) {
       // search for the best match, only look at members
 
-      if (iter.value()->definitionType() == Definition::TypeMember) {
+      if (symbol.definitionType() == Definition::TypeMember) {
          // which are also typedefs
-         QSharedPointer<Definition> sharedPtr = sharedFrom(iter.value());
+         QSharedPointer<Definition> sharedPtr = sharedFrom(symbol.def);
          QSharedPointer<MemberDef> md = sharedPtr.dynamicCast<MemberDef>();
 
          if (md->isTypedef()) {
@@ -707,8 +718,6 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
             }
          }
       }
-
-      ++iter;
    }
 
    if (bestMatch) {
@@ -861,11 +870,12 @@ static bool accessibleViaUsingNamespace(const NamespaceSDict *nl, QSharedPointer
          if (! visitedDict.contains(key)) {
             visitedDict.insert(key);
 
-            if (accessibleViaUsingNamespace(&(und->getUsedNamespaces()), fileScope, item, explicitScopePart)) {
+            bool found = accessibleViaUsingNamespace(&(und->getUsedNamespaces()), fileScope, item, explicitScopePart);
+            visitedDict.remove(key);
+
+            if (found) {
                return true;
             }
-
-            visitedDict.remove(key);
          }
 
       }
@@ -950,10 +960,299 @@ class AccessStack
    AccessElem m_elements[MAX_STACK_SIZE];
 };
 
+/** Index of the scopes and classes visible from a scope through its outer scopes, using directives
+ *  and using declarations. Once all using relations are known isAccessibleFrom() looks up the
+ *  distance of an item instead of walking the outer scopes and the used namespaces for every item.
+ *  Entries are added on demand, the mutex allows concurrent callers of getResolvedClass().
+ */
+class AccessIndex
+{
+ public:
+   AccessIndex() : m_enabled(false)
+   {}
+
+   bool isEnabled() const {
+      return m_enabled;
+   }
+
+   void enable() {
+      m_enabled = true;
+   }
+
+   void invalidate() {
+      QMutexLocker lock(&m_mutex);
+
+      m_scopes.clear();
+      m_usings.clear();
+      m_chainMembers.clear();
+   }
+
+   void scopeMoved(const Definition *def) {
+      QMutexLocker lock(&m_mutex);
+
+      if (m_chainMembers.contains(def)) {
+         m_scopes.clear();
+         m_usings.clear();
+         m_chainMembers.clear();
+      }
+   }
+
+   int distance(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item);
+
+ private:
+   struct UsingInfo {
+      QWeakPointer<Definition> owner;
+
+      QSet<const Definition *> namespaces;     // used namespaces and the namespaces used by them
+      QSet<const Definition *> classes;        // classes imported by using declarations
+   };
+
+   struct ScopeInfo {
+      QWeakPointer<Definition> scope;
+
+      QHash<const Definition *, int> scopes;   // outer scope of an item => distance
+      QHash<const Definition *, int> classes;  // item imported by a using declaration => distance
+      QVector<QPair<QWeakPointer<ClassDef>, int>> classLevels;   // weak, the index does not keep classes alive
+
+      int globalDistance;                      // -1 if the outer scopes do not end at the global scope
+   };
+
+   static void setMinDistance(QHash<const Definition *, int> &map, const Definition *def, int distance) {
+      auto iter = map.find(def);
+
+      if (iter == map.end()) {
+         map.insert(def, distance);
+
+      } else if (distance < iter.value()) {
+         iter.value() = distance;
+      }
+   }
+
+   const UsingInfo &usingInfo(QSharedPointer<Definition> owner);
+   const ScopeInfo &scopeInfo(QSharedPointer<Definition> scopeDef);
+
+   bool m_enabled;
+
+   QMutex m_mutex;
+
+   QHash<const Definition *, ScopeInfo> m_scopes;
+   QHash<const Definition *, UsingInfo> m_usings;
+
+   // definitions which are part of the outer scopes of an indexed scope
+   QSet<const Definition *> m_chainMembers;
+};
+
+const AccessIndex::UsingInfo &AccessIndex::usingInfo(QSharedPointer<Definition> owner)
+{
+   auto iter = m_usings.find(owner.data());
+
+   if (iter != m_usings.end() && ! iter->owner.isNull()) {
+      return iter.value();
+   }
+
+   UsingInfo info;
+   info.owner = owner;
+
+   const NamespaceSDict *usedNamespaces = nullptr;
+
+   if (owner->definitionType() == Definition::TypeNamespace) {
+      QSharedPointer<NamespaceDef> nd = owner.dynamicCast<NamespaceDef>();
+
+      usedNamespaces = &nd->getUsedNamespaces();
+
+      for (auto ucd : nd->getUsedClasses()) {
+         info.classes.insert(ucd.data());
+      }
+
+   } else if (owner->definitionType() == Definition::TypeFile) {
+      QSharedPointer<FileDef> fd = owner.dynamicCast<FileDef>();
+
+      usedNamespaces = fd->getUsedNamespaces();
+
+      if (fd->getUsedClasses()) {
+         for (auto ucd : *fd->getUsedClasses()) {
+            info.classes.insert(ucd.data());
+         }
+      }
+   }
+
+   if (usedNamespaces) {
+      QVector<QSharedPointer<NamespaceDef>> pending;
+
+      for (auto und : *usedNamespaces) {
+         pending.append(und);
+      }
+
+      while (! pending.isEmpty()) {
+         QSharedPointer<NamespaceDef> und = pending.takeLast();
+
+         if (info.namespaces.contains(und.data())) {
+            continue;
+         }
+
+         info.namespaces.insert(und.data());
+
+         for (auto next : und->getUsedNamespaces()) {
+            pending.append(next);
+         }
+      }
+   }
+
+   return m_usings[owner.data()] = info;
+}
+
+const AccessIndex::ScopeInfo &AccessIndex::scopeInfo(QSharedPointer<Definition> scopeDef)
+{
+   auto iter = m_scopes.find(scopeDef.data());
+
+   if (iter != m_scopes.end() && ! iter->scope.isNull()) {
+      return iter.value();
+   }
+
+   ScopeInfo info;
+   info.scope          = scopeDef;
+   info.globalDistance = -1;
+
+   QSharedPointer<Definition> current = scopeDef;
+   int distance = 0;
+
+   // same order as the recursive search, each outer scope adds a distance of two
+   while (current) {
+      m_chainMembers.insert(current.data());
+      setMinDistance(info.scopes, current.data(), distance);
+
+      if (current == Doxy_Globals::globalScope) {
+         info.globalDistance = distance;
+         break;
+      }
+
+      if (current->definitionType() == Definition::TypeClass) {
+         info.classLevels.append(qMakePair(QWeakPointer<ClassDef>(current.dynamicCast<ClassDef>()), distance));
+
+      } else if (current->definitionType() == Definition::TypeNamespace) {
+         const UsingInfo &used = usingInfo(current);
+
+         for (auto nd : used.namespaces) {
+            setMinDistance(info.scopes, nd, distance);
+         }
+
+         for (auto cd : used.classes) {
+            setMinDistance(info.classes, cd, distance);
+         }
+      }
+
+      current   = current->getOuterScope();
+      distance += 2;
+   }
+
+   return m_scopes[scopeDef.data()] = info;
+}
+
+int AccessIndex::distance(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item)
+{
+   QMutexLocker lock(&m_mutex);
+
+   const ScopeInfo &info = scopeInfo(scopeDef);
+   QSharedPointer<Definition> itemScope = item->getOuterScope();
+
+   int result = info.scopes.value(itemScope.data(), -1);
+
+   auto addCandidate = [&result](int distance) {
+      if (distance != -1 && (result == -1 || distance < result)) {
+         result = distance;
+      }
+   };
+
+   addCandidate(info.classes.value(item.data(), -1));
+
+   if (fileScope && info.globalDistance != -1) {
+      const UsingInfo &used = usingInfo(fileScope);
+
+      if (used.classes.contains(item.data()) || used.namespaces.contains(itemScope.data())) {
+         addCandidate(info.globalDistance);
+      }
+   }
+
+   if (itemScope && itemScope->definitionType() == Definition::TypeClass) {
+      bool isMember = (item->definitionType() == Definition::TypeMember);
+      bool isClass  = (item->definitionType() == Definition::TypeClass);
+
+      for (const auto &level : info.classLevels) {
+         if (result != -1 && level.second >= result) {
+            break;
+         }
+
+         QSharedPointer<ClassDef> cd = level.first.toStrongRef();
+
+         if (cd == nullptr) {
+            continue;
+         }
+
+         if (isMember && cd->isAccessibleMember(item.dynamicCast<MemberDef>())) {
+            addCandidate(level.second);
+            break;
+         }
+
+         if (isClass && cd->isBaseClass(itemScope.dynamicCast<ClassDef>(), true)) {
+            // penalty for a nested class inside a base class
+            addCandidate(level.second + 1);
+            break;
+         }
+      }
+   }
+
+   return result;
+}
+
+static AccessIndex s_accessIndex;
+
+void enableAccessIndex()
+{
+   s_accessIndex.invalidate();
+   s_accessIndex.enable();
+}
+
+void invalidateAccessIndex()
+{
+   s_accessIndex.invalidate();
+}
+
+void accessIndexScopeMoved(const Definition *def)
+{
+   s_accessIndex.scopeMoved(def);
+}
+
+static int isAccessibleFromRec(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope,
+                  QSharedPointer<Definition> item);
+
 /* Returns the "distance" (=number of levels up) from item to scope, or -1
  * if item in not inside scope.
  */
 int isAccessibleFrom(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item)
+{
+   if (! s_accessIndex.isEnabled()) {
+      return isAccessibleFromRec(scopeDef, fileScope, item);
+   }
+
+   int result = s_accessIndex.distance(scopeDef, fileScope, item);
+
+   if (Debug::isFlagSet(Debug::Access)) {
+      // compare with the recursive search
+      int expected = isAccessibleFromRec(scopeDef, fileScope, item);
+
+      if (result != expected) {
+         Debug::print(Debug::Access, 0, "isAccessibleFrom: distance of %s from %s is %d, the access index returned %d\n",
+                  csPrintable(item->qualifiedName()), csPrintable(scopeDef->name()), expected, result);
+
+         result = expected;
+      }
+   }
+
+   return result;
+}
+
+static int isAccessibleFromRec(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope,
+                  QSharedPointer<Definition> item)
 {
    static AccessStack accessStack;
 
@@ -1029,7 +1328,7 @@ int isAccessibleFrom(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef
       }
 
       // repeat for the parent scope
-      i = isAccessibleFrom(scopeDef->getOuterScope(), fileScope, item);
+      i = isAccessibleFromRec(scopeDef->getOuterScope(), fileScope, item);
       result = (i == -1) ? -1 : i + 2;
    }
 
@@ -1329,44 +1628,83 @@ static void getResolvedSymbol(QSharedPointer<Definition> scope, QSharedPointer<F
    }
 }
 
-/* Find the fully qualified class name referred to by the input class or typedef name in the input scope
- * Loops through scope and each of its parent scopes looking for a match with the input name
- * Can recursively call itself when resolving typedefs
- */
-static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope,
-                  const QString &nameType, QSharedPointer<MemberDef> *pTypeDef, QString *pTemplSpec, QString *pResolvedType )
-{
+// name searched by getResolvedClassRec, split into the unqualified name and the explicit scope
+struct LookupName {
    QString name;
    QString explicitScopePart;
    QString strippedTemplateParams;
+};
 
-   name = stripTemplateSpecifiersFromScope(removeRedundantWhiteSpace(nameType), true, &strippedTemplateParams);
+// the stripped name depends on which template specializations exist, cleared with the lookup cache
+static QMutex s_lookupNameMutex;
+static QHash<QString, LookupName> s_lookupNames;
 
-   ArgumentList actTemplParams;
+void clearLookupNameCache()
+{
+   QMutexLocker lock(&s_lookupNameMutex);
+   s_lookupNames.clear();
+}
 
-   if (! strippedTemplateParams.isEmpty()) {
-      // template part which was stripped
-      actTemplParams = stringToArgumentList(strippedTemplateParams);
+static LookupName splitLookupName(const QString &nameType)
+{
+   {
+      QMutexLocker lock(&s_lookupNameMutex);
+      auto iter = s_lookupNames.constFind(nameType);
+
+      if (iter != s_lookupNames.constEnd()) {
+         return iter.value();
+      }
    }
 
-   int qualifierIndex = computeQualifiedIndex(name);
+   LookupName retval;
+   retval.name = stripTemplateSpecifiersFromScope(removeRedundantWhiteSpace(nameType), true, &retval.strippedTemplateParams);
+
+   int qualifierIndex = computeQualifiedIndex(retval.name);
 
    if (qualifierIndex != -1) {
       // qualified name, split off the explicit scope part
-      explicitScopePart = name.left(qualifierIndex);
+      retval.explicitScopePart = retval.name.left(qualifierIndex);
+      retval.name = retval.name.mid(qualifierIndex + 2);
+   }
+
+   retval.name = StringPool::intern(retval.name);
 
+   QMutexLocker lock(&s_lookupNameMutex);
+
+   if (s_lookupNames.size() >= Doxy_Globals::lookupCache.maxSize()) {
+      // bounded like the lookup cache, start over when full
+      s_lookupNames.clear();
+   }
+
+   s_lookupNames.insert(nameType, retval);
+
+   return retval;
+}
+
+/* Find the fully qualified class name referred to by the input class or typedef name in the input scope
+ * Loops through scope and each of its parent scopes looking for a match with the input name
+ * Can recursively call itself when resolving typedefs
+ */
+static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope,
+                  const QString &nameType, QSharedPointer<MemberDef> *pTypeDef, QString *pTemplSpec, QString *pResolvedType )
+{
+   LookupName lookupName = splitLookupName(nameType);
+
+   QString name              = lookupName.name;
+   QString explicitScopePart = lookupName.explicitScopePart;
+
+   if (! explicitScopePart.isEmpty()) {
       // todo: improve namespace alias substitution
       replaceNamespaceAliases(explicitScopePart, explicitScopePart.length());
-      name = name.mid(qualifierIndex + 2);
    }
 
    if (name.isEmpty()) {
       return QSharedPointer<ClassDef>();
    }
 
-   auto iter = Doxy_Globals::glossary().find(name);
+   const SymbolList *symbols = Doxy_Globals::glossary().find(name);
 
-   if (iter == Doxy_Globals::glossary().end() ) {
+   if (symbols == nullptr) {
       // -p (for ObjC protocols)
 
       if (! Doxy_Globals::glossary().contains(name + "-p")) {
@@ -1380,54 +1718,44 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
 
    // it is often the case that the same name is searched in the same scope
    // use a cache to collect previous results
-   // the key is the concatenated scope, the name to search for and the explicit scope prefix
-
-   int scopeNameLen    = scope->name().length() + 1;
-   int nameLen         = name.length() + 1;
-   int explicitPartLen = explicitScopePart.length();
-
-   int fileScopeLen;
-
-   if (hasUsingStatements) {
-       fileScopeLen = 1 + fileScope->getFilePath().length();
-
-   } else {
-      fileScopeLen = 0;
-
-   }
 
-   QString key = scope->name( ) + "+" + name + "+" + explicitScopePart;
-
-   // if a file scope is given and contains using statements we should also use the file part
+   // if a file scope is given and contains using statements we should also use the file
    // in the key (as a class name can be in two different namespaces and a using statement in
    // a file can select one of them)
 
-   if (hasUsingStatements) {
-      key += "+" + fileScope->name();
-   }
+   LookupKey key;
+   key.scope             = scope.data();
+   key.fileScope         = hasUsingStatements ? fileScope.data() : nullptr;
+   key.name              = name;
+   key.explicitScopePart = explicitScopePart;
 
-   LookupInfo *pval = Doxy_Globals::lookupCache.object(key);
+   LookupInfo cachedInfo;
 
-   if (pval) {
+   if (s_lookupsInProgress.contains(key) || Doxy_Globals::lookupCache.find(key, cachedInfo)) {
+      // a lookup which is in progress in this thread resolves to nothing, avoids endless recursion
 
       if (pTemplSpec) {
-         *pTemplSpec = pval->templSpec;
+         *pTemplSpec = cachedInfo.templSpec;
       }
 
       if (pTypeDef) {
-         *pTypeDef = pval->typeDef;
+         *pTypeDef = cachedInfo.typeDef;
       }
 
       if (pResolvedType) {
-         *pResolvedType = pval->resolvedType;
+         *pResolvedType = cachedInfo.resolvedType;
       }
 
-      return pval->classDef;
+      return cachedInfo.classDef;
+   }
+
+   s_lookupsInProgress.insert(key);
 
-   } else {
-      // not found, add a null object to avoid endless recursion
-      Doxy_Globals::lookupCache.insert(key, new LookupInfo);
+   ArgumentList actTemplParams;
 
+   if (! lookupName.strippedTemplateParams.isEmpty()) {
+      // template part which was stripped
+      actTemplParams = stringToArgumentList(lookupName.strippedTemplateParams);
    }
 
    QSharedPointer<ClassDef>  bestMatch;
@@ -1439,12 +1767,13 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
    // init at "infinite"
    int minDistance = 10000;
 
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == name)  {
-      QSharedPointer<Definition> def = sharedFrom(iter.value());
+   if (symbols != nullptr) {
+      for (const auto &symbol : *symbols) {
+         QSharedPointer<Definition> def = sharedFrom(symbol.def);
 
-      getResolvedSymbol(scope, fileScope, def, explicitScopePart, &actTemplParams,
-                        minDistance, bestMatch, bestTypedef, bestTemplSpec, bestResolvedType);
-      ++iter;
+         getResolvedSymbol(scope, fileScope, def, explicitScopePart, &actTemplParams,
+                           minDistance, bestMatch, bestTypedef, bestTemplSpec, bestResolvedType);
+      }
    }
 
    if (pTypeDef) {
@@ -1459,21 +1788,10 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
       *pResolvedType = bestResolvedType;
    }
 
-   pval = Doxy_Globals::lookupCache.object(key);
-
-   if (pval) {
-      // updates existing cache entry
+   s_lookupsInProgress.remove(key);
 
-      pval->classDef     = bestMatch;
-      pval->typeDef      = bestTypedef;
-      pval->templSpec    = bestTemplSpec;
-      pval->resolvedType = bestResolvedType;
-
-   } else {
-      // not likely to get to this code, only way is if the cache expired an entry
-      Doxy_Globals::lookupCache.insert(key, new LookupInfo(bestMatch, bestTypedef, bestTemplSpec,
-                  bestResolvedType));
-   }
+   Doxy_Globals::lookupCache.insert(key, scope, hasUsingStatements ? fileScope : QSharedPointer<FileDef>(),
+                  LookupInfo(bestMatch, bestTypedef, bestTemplSpec, bestResolvedType));
 
    return bestMatch;
 }
@@ -1564,13 +1882,8 @@ static bool findOperator2(const QString &s, int i)
 static const char constScope[]   = { 'c', 'o', 'n', 's', 't', ':' };
 static const char virtualScope[] = { 'v', 'i', 'r', 't', 'u', 'a', 'l', ':' };
 
-// note: this function is not reentrant due to the use of a static buffer
-QString removeRedundantWhiteSpace(const QString &str, bool makePretty)
+static QString normalizeWhiteSpace(const QString &str, bool makePretty)
 {
-   if (str.isEmpty()) {
-      return str;
-   }
-
    static bool cliSupport = Config::getBool("cpp-cli-support");
 
    QString retval;
@@ -1779,6 +2092,70 @@ QString removeRedundantWhiteSpace(const QString &str, bool makePretty)
    return retval;
 }
 
+// returns true if normalizeWhiteSpace() would not change str, only recognizes identifiers
+// separated by "::" or by a single space
+static bool isNormalizedWhiteSpace(const QString &str)
+{
+   int len = str.length();
+
+   for (int i = 0; i < len; i++) {
+      QChar c = str.at(i);
+
+      if (c == ' ') {
+         if (i == 0 || i == len - 1 || ! isId(str.at(i - 1)) || ! isId(str.at(i + 1))) {
+            return false;
+         }
+
+      } else if (c.isSpace() || (c != ':' && ! isId(c))) {
+         return false;
+      }
+   }
+
+   // const::A and virtual::A are changed to const ::A and virtual ::A
+   return ! str.contains("const:") && ! str.contains("virtual:");
+}
+
+// longer strings are rarely normalized twice and are not added to the cache
+static const int MAX_NORMALIZED_LENGTH = 256;
+static const int MAX_NORMALIZED_COUNT  = 65536;
+
+static QMutex                  s_whiteSpaceMutex;
+static QHash<QString, QString> s_whiteSpaceCache[2];      // indexed by makePretty
+
+QString removeRedundantWhiteSpace(const QString &str, bool makePretty)
+{
+   if (str.isEmpty() || isNormalizedWhiteSpace(str)) {
+      // return the same string, no copy is made
+      return str;
+   }
+
+   if (str.length() > MAX_NORMALIZED_LENGTH) {
+      return normalizeWhiteSpace(str, makePretty);
+   }
+
+   QHash<QString, QString> &cache = s_whiteSpaceCache[makePretty ? 1 : 0];
+
+   {
+      QMutexLocker lock(&s_whiteSpaceMutex);
+
+      auto iter = cache.constFind(str);
+
+      if (iter != cache.constEnd()) {
+         return iter.value();
+      }
+   }
+
+   QString retval = normalizeWhiteSpace(str, makePretty);
+
+   QMutexLocker lock(&s_whiteSpaceMutex);
+
+   if (cache.size() < MAX_NORMALIZED_COUNT) {
+      cache.insert(str, retval);
+   }
+
+   return retval;
+}
+
 /**
  * Returns the position in the string where a function parameter list
  * begins, or -1 if one is not found.
@@ -2321,11 +2698,16 @@ QString getFileFilter(const QString &name, bool isSourceCode)
 
 QString transcodeToQString(const QByteArray &input)
 {
-   static QString inputEncoding = Config::getString("input-encoding");
+   // include files are read on the clang worker threads, the default is set while the static is initialized
+   static const QString inputEncoding = [] () {
+      QString retval = Config::getString("input-encoding");
 
-   if (inputEncoding.isEmpty()) {
-      inputEncoding = "UTF-8";
-   }
+      if (retval.isEmpty()) {
+         retval = "UTF-8";
+      }
+
+      return retval;
+   } ();
 
    QTextCodec *temp = QTextCodec::codecForName(inputEncoding.toUtf8());
 
@@ -3159,7 +3541,87 @@ static QString getCanonicalTypeForIdentifier(QSharedPointer<Definition> d, QShar
    return result;
 }
 
+// identifies one canonical type computed by extractCanonicalType()
+struct CanonicalTypeKey {
+   const Definition *scope;
+   const FileDef    *fileScope;
+
+   QString type;
+
+   bool operator==(const CanonicalTypeKey &other) const {
+      return scope == other.scope && fileScope == other.fileScope && type == other.type;
+   }
+};
+
+inline uint qHash(const CanonicalTypeKey &key)
+{
+   uint retval = qHash(key.type);
+
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.scope));
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.fileScope));
+
+   return retval;
+}
+
+struct CanonicalTypeInfo {
+   QWeakPointer<Definition> scope;
+   QWeakPointer<FileDef>    fileScope;
+   QString canType;
+};
+
+// the same argument types are resolved for every declaration which is matched against a definition
+static QMutex s_canonicalTypeMutex;
+static QHash<CanonicalTypeKey, CanonicalTypeInfo> s_canonicalTypeCache;
+
+static long s_canonicalTypeLookups = 0;
+static long s_canonicalTypeHits    = 0;
+
+static QString computeCanonicalType(QSharedPointer<Definition> def, QSharedPointer<FileDef> fs, QString type);
+
 static QString extractCanonicalType(QSharedPointer<Definition> def, QSharedPointer<FileDef> fs, QString type)
+{
+   CanonicalTypeKey key = {def.data(), fs.data(), type};
+
+   {
+      QMutexLocker lock(&s_canonicalTypeMutex);
+
+      ++s_canonicalTypeLookups;
+
+      auto iter = s_canonicalTypeCache.constFind(key);
+
+      // ignore the entry if a scope was deleted and the address was reused
+      if (iter != s_canonicalTypeCache.constEnd() && (def == nullptr || ! iter->scope.isNull()) &&
+            (fs == nullptr || ! iter->fileScope.isNull())) {
+
+         ++s_canonicalTypeHits;
+         return iter->canType;
+      }
+   }
+
+   // lock is not held since resolving the type can recurse
+   QString canType = computeCanonicalType(def, fs, type);
+
+   QMutexLocker lock(&s_canonicalTypeMutex);
+   s_canonicalTypeCache.insert(key, CanonicalTypeInfo{def, fs, canType});
+
+   return canType;
+}
+
+void clearCanonicalTypeCache()
+{
+   QMutexLocker lock(&s_canonicalTypeMutex);
+   s_canonicalTypeCache.clear();
+}
+
+void addCanonicalTypeStatistics()
+{
+   QMutexLocker lock(&s_canonicalTypeMutex);
+
+   Doxy_Globals::infoLog_Stat.addCounter("canonical type lookups",       s_canonicalTypeLookups);
+   Doxy_Globals::infoLog_Stat.addCounter("canonical type lookups cached", s_canonicalTypeHits);
+}
+
+static QString computeCanonicalType(QSharedPointer<Definition> def, QSharedPointer<FileDef> fs, QString type)
 {
    type = type.trimmed();
 
@@ -3330,21 +3792,7 @@ bool matchArguments2(QSharedPointer<Definition> srcScope, QSharedPointer<FileDef
    }
 */
 
-   if (srcArgList.count() != dstArgList.count()) {
-      return false;
-   }
-
-   if (checkCV) {
-      if (srcArgList.constSpecifier != dstArgList.constSpecifier) {
-         return false;
-      }
-
-      if (srcArgList.volatileSpecifier != dstArgList.volatileSpecifier) {
-         return false;
-      }
-   }
-
-   if (srcArgList.refSpecifier != dstArgList.refSpecifier) {
+   if (! srcArgList.sameShape(dstArgList, checkCV)) {
       return false;
    }
 
@@ -3477,6 +3925,14 @@ static void findMembersWithSpecificName(QSharedPointer<MemberName> mn, const QSt
                   QSharedPointer<FileDef> currentFile, bool checkCV, const QString &forceTagFile,
                   QList<QSharedPointer<MemberDef>> &members)
 {
+   // parsed once, the canonical types are resolved again for every candidate
+   ArgumentList argList;
+   bool hasArgs = ! args.isEmpty() && args != "()";
+
+   if (hasArgs) {
+      argList = stringToArgumentList(args);
+   }
+
    for (auto md : *mn) {
       QSharedPointer<FileDef> fd  = md->getFileDef();
       QSharedPointer<GroupDef> gd = md->getGroupDef();
@@ -3487,12 +3943,11 @@ static void findMembersWithSpecificName(QSharedPointer<MemberName> mn, const QSt
 
          // statics must appear in the same file
          bool match = true;
-         ArgumentList argList;
 
-         if (! md->isDefine() && ! args.isEmpty() && args != "()") {
+         if (! md->isDefine() && hasArgs) {
             const ArgumentList &mdAl = md->getArgumentList();
-            argList = stringToArgumentList(args);
 
+            argList.clearCanonicalTypes();
             match = matchArguments2(md->getOuterScope(), fd, mdAl, Doxy_Globals::globalScope, fd, argList, checkCV);
          }
 
@@ -3524,7 +3979,7 @@ static void findMembersWithSpecificName(QSharedPointer<MemberName> mn, const QSt
  *   - if `nd' is non zero, the member was found in a namespace pointed to by nd
  *   - if `fd' is non zero, the member was found in the global namespace of file fd.
  */
-bool getDefs(const QString &scName, const QString &mbName, const QString &args, QSharedPointer<MemberDef> &md,
+static bool computeDefs(const QString &scName, const QString &mbName, const QString &args, QSharedPointer<MemberDef> &md,
              QSharedPointer<ClassDef> &cd, QSharedPointer<FileDef> &fd, QSharedPointer<NamespaceDef> &nd,
              QSharedPointer<GroupDef> &gd, bool forceEmptyScope, QSharedPointer<FileDef> currentFile,
              bool checkCV, const QString &forceTagFile)
@@ -3739,7 +4194,7 @@ bool getDefs(const QString &scName, const QString &mbName, const QString &args,
             break;
          }
 
-         ArgumentList mmdAl = item->getArgumentList();
+         const ArgumentList &mmdAl = item->getArgumentList();
 
          if (matchArguments2(item->getOuterScope(), item->getFileDef(), mmdAl,
                              Doxy_Globals::globalScope, item->getFileDef(), argList, checkCV)) {
@@ -3787,6 +4242,12 @@ bool getDefs(const QString &scName, const QString &mbName, const QString &args,
          if (! namespaceName.isEmpty() && (fnd = Doxy_Globals::namespaceSDict.find(namespaceName)) && fnd->isLinkable()) {
             bool found = false;
 
+            ArgumentList argList;
+
+            if (! args.isEmpty() && args != "()") {
+               argList = stringToArgumentList(args);
+            }
+
             for (auto mmd : *mn) {
 
                if (found) {
@@ -3814,12 +4275,11 @@ bool getDefs(const QString &scName, const QString &mbName, const QString &args,
                   // namespace is found
 
                   bool match = true;
-                  ArgumentList argList;
 
                   if (! args.isEmpty() && args != "()") {
                      const ArgumentList &mmdAl = mmd->getArgumentList();
 
-                     argList = stringToArgumentList(args);
+                     argList.clearCanonicalTypes();
                      match   = matchArguments2(mmd->getOuterScope(), mmd->getFileDef(), mmdAl,
                                    fnd, mmd->getFileDef(), argList, checkCV);
                   }
@@ -3979,6 +4439,153 @@ bool getDefs(const QString &scName, const QString &mbName, const QString &args,
    return false;
 }
 
+// once all definitions are known the result of getDefs() and resolveRef() only depends on the
+// arguments, the same references are resolved on nearly every page of the output
+struct DefsKey {
+   QString scopeName;
+   QString memberName;
+   QString args;
+   QString forceTagFile;
+
+   const FileDef *currentFile;
+
+   bool forceEmptyScope;
+   bool checkCV;
+
+   bool operator==(const DefsKey &other) const {
+      return scopeName == other.scopeName && memberName == other.memberName && args == other.args &&
+             forceTagFile == other.forceTagFile && currentFile == other.currentFile &&
+             forceEmptyScope == other.forceEmptyScope && checkCV == other.checkCV;
+   }
+};
+
+inline uint qHash(const DefsKey &key)
+{
+   uint retval = qHash(key.memberName);
+
+   retval = retval * 31 + qHash(key.scopeName);
+   retval = retval * 31 + qHash(key.args);
+   retval = retval * 31 + qHash(key.forceTagFile);
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.currentFile));
+   retval = retval * 31 + (key.forceEmptyScope ? 1 : 0) + (key.checkCV ? 2 : 0);
+
+   return retval;
+}
+
+struct DefsResult {
+   bool found;
+
+   QSharedPointer<MemberDef>    md;
+   QSharedPointer<ClassDef>     cd;
+   QSharedPointer<FileDef>      fd;
+   QSharedPointer<NamespaceDef> nd;
+   QSharedPointer<GroupDef>     gd;
+};
+
+struct RefKey {
+   QString scopeName;
+   QString name;
+
+   const FileDef *currentFile;
+
+   bool inSeeBlock;
+   bool useBaseTemplateOnly;
+   bool checkScope;
+
+   bool operator==(const RefKey &other) const {
+      return scopeName == other.scopeName && name == other.name && currentFile == other.currentFile &&
+             inSeeBlock == other.inSeeBlock && useBaseTemplateOnly == other.useBaseTemplateOnly &&
+             checkScope == other.checkScope;
+   }
+};
+
+inline uint qHash(const RefKey &key)
+{
+   uint retval = qHash(key.name);
+
+   retval = retval * 31 + qHash(key.scopeName);
+   retval = retval * 31 + qHash(reinterpret_cast<quintptr>(key.currentFile));
+   retval = retval * 31 + (key.inSeeBlock ? 1 : 0) + (key.useBaseTemplateOnly ? 2 : 0) + (key.checkScope ? 4 : 0);
+
+   return retval;
+}
+
+struct RefResult {
+   bool found;
+
+   QSharedPointer<Definition> context;
+   QSharedPointer<MemberDef>  member;
+};
+
+// definitions are not deleted while the output is generated, so the keys can use addresses
+static bool s_resolveCacheEnabled = false;
+
+static QReadWriteLock s_resolveCacheLock;
+static QHash<DefsKey, DefsResult> s_defsCache;
+static QHash<RefKey, RefResult>   s_refCache;
+
+static std::atomic<long> s_defsLookups(0);
+static std::atomic<long> s_defsHits(0);
+static std::atomic<long> s_refLookups(0);
+static std::atomic<long> s_refHits(0);
+
+void enableResolveCache()
+{
+   QWriteLocker lock(&s_resolveCacheLock);
+
+   s_defsCache.clear();
+   s_refCache.clear();
+
+   s_resolveCacheEnabled = true;
+}
+
+void addResolveCacheStatistics()
+{
+   Doxy_Globals::infoLog_Stat.addCounter("getDefs lookups",            s_defsLookups);
+   Doxy_Globals::infoLog_Stat.addCounter("getDefs lookups cached",     s_defsHits);
+   Doxy_Globals::infoLog_Stat.addCounter("resolveRef lookups",         s_refLookups);
+   Doxy_Globals::infoLog_Stat.addCounter("resolveRef lookups cached",  s_refHits);
+}
+
+bool getDefs(const QString &scName, const QString &mbName, const QString &args, QSharedPointer<MemberDef> &md,
+             QSharedPointer<ClassDef> &cd, QSharedPointer<FileDef> &fd, QSharedPointer<NamespaceDef> &nd,
+             QSharedPointer<GroupDef> &gd, bool forceEmptyScope, QSharedPointer<FileDef> currentFile,
+             bool checkCV, const QString &forceTagFile)
+{
+   if (! s_resolveCacheEnabled) {
+      return computeDefs(scName, mbName, args, md, cd, fd, nd, gd, forceEmptyScope, currentFile, checkCV, forceTagFile);
+   }
+
+   DefsKey key = {scName, mbName, args, forceTagFile, currentFile.data(), forceEmptyScope, checkCV};
+
+   ++s_defsLookups;
+
+   {
+      QReadLocker lock(&s_resolveCacheLock);
+
+      auto iter = s_defsCache.constFind(key);
+
+      if (iter != s_defsCache.constEnd()) {
+         ++s_defsHits;
+
+         md = iter->md;
+         cd = iter->cd;
+         fd = iter->fd;
+         nd = iter->nd;
+         gd = iter->gd;
+
+         return iter->found;
+      }
+   }
+
+   bool found = computeDefs(scName, mbName, args, md, cd, fd, nd, gd, forceEmptyScope, currentFile, checkCV, forceTagFile);
+
+   QWriteLocker lock(&s_resolveCacheLock);
+   s_defsCache.insert(key, DefsResult{found, md, cd, fd, nd, gd});
+
+   return found;
+}
+
 /*!
  * Searches for a scope definition given its name as a string via parameter
  * `scope`.
@@ -4057,7 +4664,7 @@ static bool isLowerCase(const QString &str)
 /*! Returns an object given its name and context
  *  @post return value true implies *resContext != 0 or *resMember != 0
  */
-bool resolveRef(const QString &scName, const QString &tName, bool inSeeBlock, QSharedPointer<Definition> *resContext,
+static bool computeRef(const QString &scName, const QString &tName, bool inSeeBlock, QSharedPointer<Definition> *resContext,
                 QSharedPointer<MemberDef> *resMember, bool useBaseTemplateOnly, QSharedPointer<FileDef> currentFile,
                 bool checkScope)
 {
@@ -4236,6 +4843,41 @@ bool resolveRef(const QString &scName, const QString &tName, bool inSeeBlock, QS
    return false;
 }
 
+bool resolveRef(const QString &scName, const QString &tName, bool inSeeBlock, QSharedPointer<Definition> *resContext,
+                QSharedPointer<MemberDef> *resMember, bool useBaseTemplateOnly, QSharedPointer<FileDef> currentFile,
+                bool checkScope)
+{
+   if (! s_resolveCacheEnabled) {
+      return computeRef(scName, tName, inSeeBlock, resContext, resMember, useBaseTemplateOnly, currentFile, checkScope);
+   }
+
+   RefKey key = {scName, tName, currentFile.data(), inSeeBlock, useBaseTemplateOnly, checkScope};
+
+   ++s_refLookups;
+
+   {
+      QReadLocker lock(&s_resolveCacheLock);
+
+      auto iter = s_refCache.constFind(key);
+
+      if (iter != s_refCache.constEnd()) {
+         ++s_refHits;
+
+         *resContext = iter->context;
+         *resMember  = iter->member;
+
+         return iter->found;
+      }
+   }
+
+   bool found = computeRef(scName, tName, inSeeBlock, resContext, resMember, useBaseTemplateOnly, currentFile, checkScope);
+
+   QWriteLocker lock(&s_resolveCacheLock);
+   s_refCache.insert(key, RefResult{found, *resContext, *resMember});
+
+   return found;
+}
+
 QString linkToText(SrcLangExt lang, const QString &link, bool isFileName)
 {
    // static bool optimizeOutputJava = Config::getBool("optimize-java");
@@ -5610,11 +6252,17 @@ QString substituteTemplateArgumentsInString(const QString &name, const ArgumentL
  */
 QString stripTemplateSpecifiersFromScope(const QString &fullName, bool parentOnly, QString *pLastScopeStripped)
 {
+   int i = fullName.indexOf('<');
+
+   if (i == -1) {
+      // no template specifiers, return the same string
+      return fullName;
+   }
+
    QString result;
 
    int p = 0;
    int l = fullName.length();
-   int i = fullName.indexOf('<');
 
    while (i != -1) {
 
@@ -5670,6 +6318,14 @@ QString stripTemplateSpecifiersFromScope(const QString &fullName, bool parentOnl
  */
 QString mergeScopes(const QString &leftScope, const QString &rightScope)
 {
+   if (leftScope.isEmpty()) {
+      return rightScope;
+   }
+
+   if (rightScope.isEmpty()) {
+      return leftScope;
+   }
+
    // case leftScope == "A" rightScope == "A::B" => result = "A::B"
    if (leftScopeMatch(rightScope, leftScope)) {
       return rightScope;
@@ -6642,9 +7298,9 @@ QSharedPointer<MemberDef> getMemberFromSymbol(QSharedPointer<Definition> scope,
       return bestMatch;
    }
 
-   auto iter = Doxy_Globals::glossary().find(name);
+   const SymbolList *symbols = Doxy_Globals::glossary().find(name);
 
-   if (iter == Doxy_Globals::glossary().end()) {
+   if (symbols == nullptr) {
       return bestMatch;
    }
 
@@ -6666,25 +7322,20 @@ QSharedPointer<MemberDef> getMemberFromSymbol(QSharedPointer<Definition> scope,
    int minDistance = 10000;
 
    // find the closest matching definition
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == name)  {
+   for (const auto &symbol : *symbols) {
       // search for the best match, only look at members
 
-      if (iter.value()->definitionType() == Definition::TypeMember) {
+      if (symbol.definitionType() == Definition::TypeMember) {
          s_visitedNamespaces.clear();
 
-         QSharedPointer<Definition> def = sharedFrom(iter.value());
+         QSharedPointer<Definition> def = sharedFrom(symbol.def);
          int distance = isAccessibleFromWithExpScope(scope, fileScope, def, explicitScopePart);
 
          if (distance != -1 && distance < minDistance) {
             minDistance = distance;
-
-            QSharedPointer<Definition> def = sharedFrom(iter.value());
-            QSharedPointer<MemberDef> md   = def.dynamicCast<MemberDef>();
-            bestMatch = md;
+            bestMatch   = def.dynamicCast<MemberDef>();
          }
       }
-
-      ++iter;
    }
 
    return bestMatch;
@@ -136,6 +136,10 @@ bool getDefs(const QString &scName, const QString &mbName, const QString &args,
                   QSharedPointer<GroupDef> &gd, bool forceEmptyScope = false, QSharedPointer<FileDef> currentFile = QSharedPointer<FileDef>(), 
                   bool checkCV = false, const QString &forceTagFile = QString() );
 
+// getDefs() and resolveRef() remember their results once all definitions are known
+void enableResolveCache();
+void addResolveCacheStatistics();
+
 QString getFileFilter(const QString &name, bool isSourceCode);
 
 int getPrefixIndex(const QString &name);
@@ -160,6 +164,13 @@ bool matchArguments2(QSharedPointer<Definition> srcScope, QSharedPointer<FileDef
 
 void mergeArguments(ArgumentList &srcArgList, ArgumentList &dstArgList, bool forceNameOverwrite = false);
 
+// canonical argument types depend on the classes getResolvedClass() finds
+void clearCanonicalTypeCache();
+void addCanonicalTypeStatistics();
+
+// names split by getResolvedClass() depend on the classes which exist, cleared with the lookup cache
+void clearLookupNameCache();
+
 
 QSharedPointer<ClassDef> getClass(const QString &key);
 
@@ -274,6 +285,11 @@ void replaceNamespaceAliases(QString &scope, int i);
 
 int isAccessibleFrom(QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item);
 
+// isAccessibleFrom() uses an index of the visible scopes once all using relations are known
+void enableAccessIndex();
+void invalidateAccessIndex();
+void accessIndexScopeMoved(const Definition *def);
+
 int computeQualifiedIndex(const QString &name);
 
 void addDirPrefix(QByteArray &fileName);